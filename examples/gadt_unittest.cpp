@@ -36,6 +36,12 @@ namespace gadt
 				state.next_player = action.player == WHITE ? BLACK : WHITE;
 			}
 
+			void UndoState(State& state, const Action& action)
+			{
+				state.dot[action.x][action.y] = EMPTY;
+				state.next_player = action.player;
+			}
+
 			void MakeAction(const State& state, ActionSet& as)
 			{
 				for (size_t x = 0; x < 3; x++)
@@ -104,6 +110,25 @@ namespace gadt
 				return false;
 			}
 
+			//the player who takes the center is regarded as the winner of truncated simulation.
+			double EvaluateRollout(const State& state, const State& rollout_state)
+			{
+				return rollout_state.dot[1][1] == state.next_player ? 1 : 0;
+			}
+
+			uint64_t StateHash(const State& state)
+			{
+				uint64_t hash = 1;
+				for (size_t x = 0; x < 3; x++)
+				{
+					for (size_t y = 0; y < 3; y++)
+					{
+						hash = hash * 3 + (state.dot[x][y] == BLACK ? 1 : (state.dot[x][y] == WHITE ? 2 : 0));
+					}
+				}
+				return hash * 2 + (state.next_player == BLACK ? 0 : 1);
+			}
+
 			std::string StateToStr(const State& state)
 			{
 				std::stringstream ss;
@@ -155,6 +180,75 @@ namespace gadt
 			}
 		}
 
+		namespace dice_race
+		{
+			void UpdateState(State& state, const Action& action)
+			{
+				if (state.roll == 0)
+				{
+					state.roll = action.roll;
+					return;
+				}
+				state.score[state.next_player] += action.choice == 0 ? state.roll : 4 - state.roll;
+				state.roll = 0;
+				state.turn++;
+				state.next_player = 1 - state.next_player;
+			}
+
+			void MakeAction(const State& state, ActionSet& as)
+			{
+				as.push_back({ 0, 0 });
+				as.push_back({ 0, 1 });
+			}
+
+			void MakeChance(const State& state, ChanceList& chances)
+			{
+				if (state.roll == 0)
+				{
+					chances.push_back({ { 1, 0 }, 0.5 });
+					chances.push_back({ { 2, 0 }, 0.3 });
+					chances.push_back({ { 3, 0 }, 0.2 });
+				}
+			}
+
+			void ChanceOutcomes(const State& state, MctsChanceList& chances)
+			{
+				ChanceList outcomes;
+				MakeChance(state, outcomes);
+				for (const auto& outcome : outcomes)
+					chances.push_back({ outcome.action, outcome.probability });
+			}
+
+			AgentIndex DetermineWinner(const State& state)
+			{
+				if (state.turn < g_TURNS)
+					return GADT_DEFAULT_NO_WINNER_INDEX;
+				if (state.score[0] == state.score[1])
+					return 3;
+				return state.score[0] > state.score[1] ? 1 : 2;
+			}
+
+			double EvaluateState(const State& state, AgentIndex winner)
+			{
+				return double(state.score[state.next_player] - state.score[1 - state.next_player]) / (3 * g_TURNS / 2);
+			}
+
+			AgentIndex StateToResult(const State& state, AgentIndex winner)
+			{
+				return winner;
+			}
+
+			bool AllowUpdateValue(const State& state, const AgentIndex& winner)
+			{
+				return winner == state.next_player + 1;
+			}
+
+			double EvaluateRollout(const State& state, const State& rollout_state)
+			{
+				return 0.5 + double(rollout_state.score[state.next_player] - rollout_state.score[1 - state.next_player]) / (3 * g_TURNS);
+			}
+		}
+
 		void TestConvertFunc()
 		{
 			int t = 0;
@@ -493,6 +587,109 @@ namespace gadt
 			auto p = alloc.construct(state, nullptr, func, mcts::MctsSetting());
 			GADT_ASSERT(node.action_count(), 9);
 			GADT_ASSERT(p->action_count(), 9);
+
+			//a chain whose depth is far beyond the stack, the state is the depth of node.
+			const size_t chain_depth = 200000;
+			using ChainNode = mcts::MctsNode<size_t, size_t, AgentIndex, true>;
+			mcts::MctsFuncPackage<size_t, size_t, AgentIndex, true> chain_func(
+				[](size_t& depth, const size_t& action)->void { depth += action; },
+				[&](const size_t&, std::vector<size_t>& actions)->void { actions.push_back(1); },
+				[&](const size_t& depth)->AgentIndex { return depth == chain_depth ? 1 : GADT_DEFAULT_NO_WINNER_INDEX; },
+				[](const size_t&, AgentIndex winner)->AgentIndex { return winner; },
+				[](const size_t& depth, const AgentIndex&)->bool { return depth % 2 == 0; }
+			);
+			ChainNode::Allocator chain_alloc(chain_depth);
+			ChainNode chain_root(0, nullptr, chain_func, mcts::MctsSetting());
+			ChainNode* leaf = &chain_root;
+			for (size_t i = 0; i < chain_depth; i++)
+				leaf = leaf->ExpandChild(chain_alloc, chain_func, mcts::MctsSetting());
+			GADT_ASSERT(leaf->state(), chain_depth);
+			ChainNode::NodePath path;
+			GADT_ASSERT(chain_root.Selection(chain_alloc, chain_func, mcts::MctsSetting(), path), true);
+			GADT_ASSERT(path.size(), chain_depth + 1);
+			GADT_ASSERT(leaf->visit_count(), 2);
+			GADT_ASSERT(chain_root.child_node(0)->win_count(), 1);
+			chain_root.FreeChildNodes(chain_alloc);
+			GADT_ASSERT(chain_alloc.is_empty(), true);
+
+			//the fractional reward of truncated simulation is accumulated exactly.
+			mcts::MctsSetting cutoff_setting;
+			cutoff_setting.simulation_cutoff_length = 1;
+			chain_func.EvaluateRollout = [](const size_t&, const size_t&)->double { return 0.25; };
+			ChainNode cutoff_root(0, nullptr, chain_func, cutoff_setting);
+			for (size_t i = 0; i < 3; i++)
+				GADT_ASSERT(cutoff_root.Selection(chain_alloc, chain_func, cutoff_setting, path), true);
+			GADT_ASSERT(cutoff_root.child_node(0)->win_count(), 0.75);
+			GADT_ASSERT(cutoff_root.child_node(0)->avg_reward(), 0.25);
+			cutoff_root.FreeChildNodes(chain_alloc);
+
+			//the truncated simulation is evaluated once for each acting agent rather than once for each level.
+			size_t evaluate_count = 0;
+			chain_func.EvaluateRollout = [&](const size_t&, const size_t&)->double { evaluate_count++; return 0.25; };
+			chain_func.ActingAgent = [](const size_t& depth)->AgentIndex { return static_cast<AgentIndex>(depth % 2); };
+			ChainNode agent_root(0, nullptr, chain_func, cutoff_setting);
+			for (size_t i = 0; i < 4; i++)
+				GADT_ASSERT(agent_root.Selection(chain_alloc, chain_func, cutoff_setting, path), true);
+			GADT_ASSERT(evaluate_count, 7);
+			GADT_ASSERT(agent_root.child_node(0)->win_count(), 1);
+			agent_root.FreeChildNodes(chain_alloc);
+
+			//the state without any action is regarded as terminal, rather than waiting for a child node.
+			mcts::MctsFuncPackage<size_t, size_t, AgentIndex, true> stuck_func(
+				[](size_t& depth, const size_t& action)->void { depth += action; },
+				[](const size_t&, std::vector<size_t>&)->void { },
+				[](const size_t&)->AgentIndex { return GADT_DEFAULT_NO_WINNER_INDEX; },
+				[](const size_t&, AgentIndex winner)->AgentIndex { return winner; },
+				[](const size_t&, const AgentIndex&)->bool { return false; }
+			);
+			ChainNode stuck_root(0, nullptr, stuck_func, mcts::MctsSetting());
+			GADT_ASSERT(stuck_root.Selection(chain_alloc, stuck_func, mcts::MctsSetting(), path), true);
+			GADT_ASSERT(stuck_root.visit_count(), 2);
+			GADT_ASSERT(stuck_root.child_count(), 0);
+
+			//chance node, all the outcomes are expanded at once and sampled by probability.
+			using DiceNode = mcts::MctsNode<dice_race::State, dice_race::Action, AgentIndex, true>;
+			mcts::MctsFuncPackage<dice_race::State, dice_race::Action, AgentIndex, true> dice_func(
+				dice_race::UpdateState,
+				dice_race::MakeAction,
+				dice_race::DetermineWinner,
+				dice_race::StateToResult,
+				dice_race::AllowUpdateValue
+			);
+			dice_func.ChanceOutcomes = dice_race::ChanceOutcomes;
+			DiceNode::Allocator dice_alloc(10000);
+			DiceNode dice_root(dice_race::State(), nullptr, dice_func, mcts::MctsSetting());
+			GADT_ASSERT(dice_root.is_chance_node(), true);
+			GADT_ASSERT(dice_root.action_count(), 3);
+			GADT_ASSERT(dice_root.Selection(dice_alloc, dice_func, mcts::MctsSetting()), true);
+			for (size_t i = 0; i < dice_root.child_count(); i++)
+			{
+				if (dice_root.child_node(i)->visit_count() == 0)
+					GADT_ASSERT(dice_root.child_node(i)->avg_reward(), 0);
+			}
+			const size_t dice_iteration = 2999;
+			for (size_t i = 0; i < dice_iteration; i++)
+				GADT_ASSERT(dice_root.Selection(dice_alloc, dice_func, mcts::MctsSetting()), true);
+			GADT_ASSERT(dice_root.child_count(), 3);
+			GADT_ASSERT(dice_root.child_node(0)->is_chance_node(), false);
+			GADT_ASSERT(dice_root.child_node(2)->state().roll, 3);
+			GADT_ASSERT(dice_root.child_node(0)->child_node(0)->is_chance_node(), true);
+			uint32_t outcome_visit = 0;
+			for (size_t i = 0; i < dice_root.child_count(); i++)
+				outcome_visit += dice_root.child_node(i)->visit_count();
+			GADT_ASSERT(outcome_visit, dice_iteration + 1);
+			GADT_ASSERT(dice_root.child_node(0)->visit_count() > dice_root.child_node(1)->visit_count(), true);
+			GADT_ASSERT(dice_root.child_node(1)->visit_count() > dice_root.child_node(2)->visit_count(), true);
+			dice_root.FreeChildNodes(dice_alloc);
+			GADT_ASSERT(dice_alloc.is_empty(), true);
+
+			//only decision moves are counted by the cutoff, the dice rolls between them are not.
+			mcts::MctsSetting dice_cutoff_setting;
+			dice_cutoff_setting.simulation_cutoff_length = 2;
+			DiceNode dice_cutoff_root(dice_race::State(), nullptr, dice_func, dice_cutoff_setting);
+			DiceNode::Rollout dice_rollout = dice_cutoff_root.Simulation(dice_func, dice_cutoff_setting);
+			GADT_ASSERT(dice_rollout.truncated, true);
+			GADT_ASSERT(dice_rollout.state.turn, 2);
 		}
 		void TestMctsSearch()
 		{
@@ -564,7 +761,285 @@ namespace gadt
 
 			action = mt_mcts.Run(state, setting);
 			GADT_ASSERT((action.x == 1 && action.y == 1), true);
-			
+
+			//static policy.
+			mcts::StaticMonteCarloTreeSearch<tic_tac_toe::MctsPolicy, true> static_mcts;
+			action = static_mcts.Run(state, setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+
+			//compact node storage.
+			setting.node_storage = mcts::MctsNodeStorage::Compact;
+			action = mcts.Run(state, setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+
+			action = mt_mcts.Run(state, setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+
+			//the tree policy of function package which only accepts linked nodes is run by linked storage.
+			using PolicyPackage = mcts::MctsFuncPackage<tic_tac_toe::State, tic_tac_toe::Action, tic_tac_toe::Result, true>;
+			PolicyPackage policy_package
+			(
+				tic_tac_toe::UpdateState,
+				tic_tac_toe::MakeAction,
+				tic_tac_toe::DetemineWinner,
+				tic_tac_toe::StateToResult,
+				tic_tac_toe::AllowUpdateValue
+			);
+			std::atomic<size_t> policy_count(0);
+			policy_package.TreePolicyValue = [&](const PolicyPackage::Node& parent, const PolicyPackage::Node& child)->UcbValue {
+				policy_count++;
+				return PolicyPackage::DefaultPolicyBase::TreePolicyValue(parent, child);
+			};
+			mcts::MonteCarloTreeSearch<tic_tac_toe::State, tic_tac_toe::Action, tic_tac_toe::Result, true> policy_mcts(policy_package);
+			action = policy_mcts.Run(state, setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+			GADT_ASSERT(policy_count.load() > 0, true);
+
+			//truncated simulations, which are evaluated by the owner of center.
+			setting.simulation_cutoff_length = 1;
+			action = static_mcts.Run(state, setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+			setting.node_storage = mcts::MctsNodeStorage::Linked;
+			action = static_mcts.Run(state, setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+			setting.simulation_cutoff_length = 0;
+
+			//root parallelization with statistic synchronization.
+			setting.node_storage = mcts::MctsNodeStorage::Linked;
+			setting.sync_interval = 100;
+			setting.sync_depth = 2;
+			action = mt_mcts.Run(state, setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+			setting.sync_interval = 0;
+
+			//tree parallelization with virtual loss.
+			setting.node_storage = mcts::MctsNodeStorage::Linked;
+			setting.virtual_loss = 3;
+			action = lf_mcts.Run(state, setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+
+			//rewards of each player are kept in the result, a draw is half a win.
+			using RewardResult = std::array<double, 2>;
+			mcts::MctsFuncPackage<tic_tac_toe::State, tic_tac_toe::Action, RewardResult, true> reward_package
+			(
+				tic_tac_toe::UpdateState,
+				tic_tac_toe::MakeAction,
+				tic_tac_toe::DetemineWinner,
+				[](const tic_tac_toe::State&, AgentIndex winner)->RewardResult {
+					if (winner == tic_tac_toe::DRAW)
+						return { 0.5, 0.5 };
+					return { winner == tic_tac_toe::BLACK ? 1.0 : 0.0, winner == tic_tac_toe::WHITE ? 1.0 : 0.0 };
+				},
+				[](const tic_tac_toe::State& state, const RewardResult& result)->bool {
+					return result[state.next_player == tic_tac_toe::BLACK ? 0 : 1] == 1;
+				}
+			);
+			reward_package.ResultReward = [](const tic_tac_toe::State& state, const RewardResult& result)->double {
+				return result[state.next_player == tic_tac_toe::BLACK ? 0 : 1];
+			};
+			mcts::MonteCarloTreeSearch<tic_tac_toe::State, tic_tac_toe::Action, RewardResult, true> reward_mcts(reward_package);
+			action = reward_mcts.Run(state, setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+			setting.node_storage = mcts::MctsNodeStorage::Compact;
+			action = reward_mcts.Run(state, setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+			setting.node_storage = mcts::MctsNodeStorage::Linked;
+
+			//transposition table.
+			setting.transposition_table_size = 4096;
+			mcts::MctsFuncPackage<tic_tac_toe::State, tic_tac_toe::Action, tic_tac_toe::Result, true> hash_package
+			(
+				tic_tac_toe::UpdateState,
+				tic_tac_toe::MakeAction,
+				tic_tac_toe::DetemineWinner,
+				tic_tac_toe::StateToResult,
+				tic_tac_toe::AllowUpdateValue
+			);
+			hash_package.StateHash = tic_tac_toe::StateHash;
+			mcts::MonteCarloTreeSearch<tic_tac_toe::State, tic_tac_toe::Action, tic_tac_toe::Result, true> tt_mcts(hash_package);
+			action = tt_mcts.Run(state, setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+
+			action = static_mcts.Run(state, setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+			setting.transposition_table_size = 0;
+
+			//leaf parallelization.
+			setting.virtual_loss = 0;
+			setting.leaf_simulations = 4;
+			action = mcts.Run(state, setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+
+			action = lf_mcts.Run(state, setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+			setting.leaf_simulations = 1;
+
+			//tree reuse, advance the root by the actions of both players.
+			setting.virtual_loss = 0;
+			setting.max_node_per_thread = 100000;
+			tt_mcts.EnableTreeReuse();
+			tic_tac_toe::State reuse_state;
+			for (size_t step = 0; step < 2; step++)
+			{
+				action = tt_mcts.Run(reuse_state, setting);
+				size_t index = 0;
+				while (tt_mcts.tree_root()->action(index).x != action.x || tt_mcts.tree_root()->action(index).y != action.y)
+					index++;
+				GADT_ASSERT(tt_mcts.AdvanceRoot(index), true);
+				tic_tac_toe::UpdateState(reuse_state, action);
+
+				//the opponent plays the first available action.
+				tic_tac_toe::Action reply = tt_mcts.tree_root()->action(0);
+				GADT_ASSERT(tt_mcts.AdvanceRoot(0), true);
+				tic_tac_toe::UpdateState(reuse_state, reply);
+				GADT_ASSERT(tt_mcts.tree_root()->visit_count() > 0, true);
+			}
+			uint32_t reused_visit = tt_mcts.tree_root()->visit_count();
+			tt_mcts.Run(reuse_state, setting);
+			GADT_ASSERT(tt_mcts.tree_root()->visit_count(), reused_visit + setting.max_iteration_per_thread);
+
+			//the stale tree is rebuilt if the state differs from the root node.
+			tt_mcts.Run(state, setting);
+			GADT_ASSERT(tic_tac_toe::StateHash(tt_mcts.tree_root()->state()), tic_tac_toe::StateHash(state));
+			GADT_ASSERT(tt_mcts.tree_root()->visit_count(), setting.max_iteration_per_thread);
+			tt_mcts.DisableTreeReuse();
+
+			//without StateHash, the tree is only reused after its root is advanced by AdvanceRoot.
+			mcts.EnableTreeReuse();
+			action = mcts.Run(state, setting);
+			GADT_ASSERT(mcts.AdvanceRoot(action), true);
+			tic_tac_toe::State advanced_state = state;
+			tic_tac_toe::UpdateState(advanced_state, action);
+			uint32_t advanced_visit = mcts.tree_root()->visit_count();
+			mcts.Run(advanced_state, setting);
+			GADT_ASSERT(mcts.tree_root()->visit_count(), advanced_visit + setting.max_iteration_per_thread);
+			mcts.DisableTreeReuse();
+
+			//the merged tree of root parallelization is reused, whose nodes below depth 1 are merged as well.
+			//a node that is not terminal is visited once by the expansion of each tree, the other visits come from its children.
+			mcts::MultiTreeMCTS<tic_tac_toe::State, tic_tac_toe::Action, tic_tac_toe::Result, true> mt_reuse_mcts(hash_package);
+			mt_reuse_mcts.EnableTreeReuse();
+			const uint32_t mt_iteration = static_cast<uint32_t>(setting.max_thread * setting.max_iteration_per_thread);
+			action = mt_reuse_mcts.Run(state, setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+			GADT_ASSERT(mt_reuse_mcts.tree_root()->visit_count(), mt_iteration);
+			for (size_t i = 0; i < mt_reuse_mcts.tree_root()->child_count(); i++)
+			{
+				auto child = mt_reuse_mcts.tree_root()->child_node(i);
+				uint32_t grandchild_visit = 0;
+				for (size_t n = 0; n < child->child_count(); n++)
+					grandchild_visit += child->child_node(n)->visit_count();
+				GADT_ASSERT(child->visit_count() > grandchild_visit, true);
+				GADT_ASSERT(child->visit_count() <= grandchild_visit + setting.max_thread, true);
+			}
+			GADT_ASSERT(mt_reuse_mcts.AdvanceRoot(action), true);
+			tic_tac_toe::State mt_state = state;
+			tic_tac_toe::UpdateState(mt_state, action);
+			uint32_t mt_reused_visit = mt_reuse_mcts.tree_root()->visit_count();
+			GADT_ASSERT(mt_reused_visit > 0, true);
+			mt_reuse_mcts.Run(mt_state, setting);
+			GADT_ASSERT(mt_reuse_mcts.tree_root()->visit_count(), mt_reused_visit + mt_iteration);
+			mt_reuse_mcts.DisableTreeReuse();
+
+			//the trees are merged by actions even if the actions of each tree are generated in different orders.
+			mcts::MctsFuncPackage<tic_tac_toe::State, tic_tac_toe::Action, tic_tac_toe::Result, true> shuffle_package
+			(
+				tic_tac_toe::UpdateState,
+				[](const tic_tac_toe::State& state, tic_tac_toe::ActionSet& as)->void {
+					tic_tac_toe::MakeAction(state, as);
+					for (size_t i = as.size(); i > 1; i--)
+						std::swap(as[i - 1], as[random::Bounded(i)]);
+				},
+				tic_tac_toe::DetemineWinner,
+				tic_tac_toe::StateToResult,
+				tic_tac_toe::AllowUpdateValue
+			);
+			mcts::MultiTreeMCTS<tic_tac_toe::State, tic_tac_toe::Action, tic_tac_toe::Result, true> shuffle_mcts(shuffle_package);
+			shuffle_mcts.EnableTreeReuse();
+			action = shuffle_mcts.Run(state, setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+
+			//the merged nodes are all visited, which give valid values for tree policy.
+			std::vector<decltype(shuffle_mcts.tree_root())> merged_nodes = { shuffle_mcts.tree_root() };
+			while (!merged_nodes.empty())
+			{
+				auto node = merged_nodes.back();
+				merged_nodes.pop_back();
+				GADT_ASSERT(node->visit_count() > 0, true);
+				for (size_t i = 0; i < node->child_count(); i++)
+					merged_nodes.push_back(node->child_node(i));
+			}
+			shuffle_mcts.DisableTreeReuse();
+
+			//garbage collection in a small allocator, the search should not stop before the iterations are finished.
+			setting.max_node_per_thread = 1000;
+			for (auto policy : { mcts::MctsGcPolicy::PruneLeastVisited, mcts::MctsGcPolicy::CollapseColdSubtrees })
+			{
+				setting.gc_policy = policy;
+				mcts.EnableTreeReuse();
+				action = mcts.Run(state, setting);
+				GADT_ASSERT((action.x == 1 && action.y == 1), true);
+				GADT_ASSERT(mcts.tree_root()->visit_count(), setting.max_iteration_per_thread);
+				mcts.DisableTreeReuse();
+
+				action = mt_mcts.Run(state, setting);
+				GADT_ASSERT((action.x == 1 && action.y == 1), true);
+			}
+
+			//a child may be visited more than its parent in a reused tree, the nodes under a released subtree are skipped.
+			using TicTacToeNode = mcts::MctsNode<tic_tac_toe::State, tic_tac_toe::Action, tic_tac_toe::Result, true>;
+			setting.gc_policy = mcts::MctsGcPolicy::PruneLeastVisited;
+			setting.gc_low_water = 0.1;
+			tt_mcts.EnableTreeReuse();
+			tt_mcts.Run(state, setting);
+			TicTacToeNode* gc_child = nullptr;
+			for (size_t i = 0; i < tt_mcts.tree_root()->child_count(); i++)
+			{
+				TicTacToeNode* child = const_cast<TicTacToeNode*>(tt_mcts.tree_root())->child_node(i);
+				bool deep = false;
+				for (size_t n = 0; n < child->child_count(); n++)
+					deep = deep || child->child_node(n)->exist_child_node();
+				if (deep && (gc_child == nullptr || child->visit_count() < gc_child->visit_count()))
+					gc_child = child;
+			}
+			GADT_ASSERT(gc_child != nullptr, true);
+			gc_child->set_visit_count(1);
+			setting.gc_high_water = 0.2;
+			tt_mcts.Run(state, setting);
+			GADT_ASSERT(tt_mcts.tree_root()->visit_count(), 2 * setting.max_iteration_per_thread);
+			tt_mcts.DisableTreeReuse();
+			setting.gc_high_water = 0.9;
+			setting.gc_low_water = 0.6;
+			setting.gc_policy = mcts::MctsGcPolicy::None;
+
+			//chance nodes, the player rolled 1 should take 3 points instead of 1.
+			mcts::MctsFuncPackage<dice_race::State, dice_race::Action, AgentIndex, true> dice_package
+			(
+				dice_race::UpdateState,
+				dice_race::MakeAction,
+				dice_race::DetermineWinner,
+				dice_race::StateToResult,
+				dice_race::AllowUpdateValue
+			);
+			dice_package.ChanceOutcomes = dice_race::ChanceOutcomes;
+			dice_package.EvaluateRollout = dice_race::EvaluateRollout;
+			mcts::MonteCarloTreeSearch<dice_race::State, dice_race::Action, AgentIndex, true> dice_mcts(dice_package);
+			mcts::LockFreeMCTS<dice_race::State, dice_race::Action, AgentIndex, true> lf_dice_mcts(dice_package);
+			dice_race::State dice_state;
+			dice_state.roll = 1;
+			setting.max_node_per_thread = 100000;
+			dice_mcts.EnableTreeReuse();
+			GADT_ASSERT(dice_mcts.Run(dice_state, setting).choice, 1);
+			GADT_ASSERT(dice_mcts.tree_root()->child_node(0)->is_chance_node(), true);
+			GADT_ASSERT(dice_mcts.tree_root()->child_node(0)->child_count(), 3);
+			dice_mcts.DisableTreeReuse();
+			GADT_ASSERT(lf_dice_mcts.Run(dice_state, setting).choice, 1);
+
+			//truncated simulations, which are evaluated by the score difference.
+			setting.simulation_cutoff_length = 2;
+			GADT_ASSERT(dice_mcts.Run(dice_state, setting).choice, 1);
+			GADT_ASSERT(lf_dice_mcts.Run(dice_state, setting).choice, 1);
+			setting.simulation_cutoff_length = 0;
 		}
 		void TestVisualTree()
 		{
@@ -660,6 +1135,19 @@ namespace gadt
 			GADT_ASSERT(alloc.is_full(), true);
 			alloc.flush();
 			GADT_ASSERT(alloc.is_empty(), true);
+
+			//the elements of containers are aligned to cache line.
+			struct alignas(GADT_CACHE_LINE_SIZE) AlignedClass
+			{
+				size_t a;
+			};
+			std::vector<AlignedClass, stl::AlignedAllocator<AlignedClass>> aligned(ub);
+			for (size_t i = 0; i < 100; i++)
+			{
+				aligned.emplace_back();
+				GADT_ASSERT(reinterpret_cast<uintptr_t>(aligned.data()) % GADT_CACHE_LINE_SIZE, 0);
+			}
+			GADT_ASSERT(reinterpret_cast<uintptr_t>(&aligned.back()) % GADT_CACHE_LINE_SIZE, 0);
 		}
 		void TestStlLinearAlloc()
 		{
@@ -698,6 +1186,38 @@ namespace gadt
 			alloc.flush();
 			GADT_ASSERT(alloc.is_empty(), true);
 		}
+		void TestStlBlockAlloc()
+		{
+			using TestAlloc = stl::BlockAllocator<std::vector<size_t>, true>;
+			TestAlloc alloc(100);
+			std::vector<size_t>* fir = alloc.allocate(30);
+			std::vector<size_t>* sec = alloc.allocate(60);
+			GADT_ASSERT(alloc.size(), 90);
+			GADT_ASSERT(alloc.allocate(20) == nullptr, true);
+			for (size_t i = 0; i < 30; i++)
+			{
+				std::vector<size_t>* p = alloc.construct(fir + i, i, i);
+				GADT_ASSERT(p->size(), i);
+			}
+			for (size_t i = 0; i < 30; i++)
+				alloc.destory(fir + i);
+			GADT_ASSERT(alloc.deallocate(fir, 30), true);
+			GADT_ASSERT(alloc.remain_size(), 40);
+			GADT_ASSERT(alloc.allocate(30) == fir, true);
+			GADT_ASSERT(alloc.allocate(10) == sec + 60, true);
+			GADT_ASSERT(alloc.is_full(), true);
+			GADT_ASSERT(alloc.deallocate(sec, 60), true);
+			GADT_ASSERT(alloc.allocate(45) == sec, true);
+			GADT_ASSERT(alloc.allocate(15) == sec + 45, true);
+			GADT_ASSERT(alloc.is_full(), true);
+			GADT_ASSERT(alloc.deallocate(sec + 45, 15), true);
+			GADT_ASSERT(alloc.deallocate(sec, 45), true);
+			GADT_ASSERT(alloc.allocate(60) == sec, true);
+			GADT_ASSERT(alloc.deallocate(sec + 60, 10), true);
+			GADT_ASSERT(alloc.remain_size(), 10);
+			alloc.flush();
+			GADT_ASSERT(alloc.is_empty(), true);
+		}
 		void TestStlDynamicMatrix()
 		{
 			stl::DynamicMatrix<size_t>::ElementToStringFunc ElemToString = [](const size_t& i)->std::string {
@@ -897,6 +1417,216 @@ namespace gadt
 			action = minimax.RunAlphabeta(state, typename Minimax::Setting{ timeout, max_depth });
 			GADT_ASSERT((action.x == 1 && action.y == 1), true);
 			GADT_ASSERT(0, minimax.GetEvalType(state, typename Minimax::Setting{ timeout, max_depth }));
+
+			//transposition table.
+			minimax::MinimaxTranspositionTable<int64_t> table(100);
+			GADT_ASSERT(table.size(), 100);
+			typename minimax::MinimaxTranspositionTable<int64_t>::Entry entry;
+			GADT_ASSERT(table.probe(42, entry), false);
+			table.store(42, -7, 3, minimax::MinimaxBound::Lower, 5);
+			GADT_ASSERT(table.probe(42, entry), true);
+			GADT_ASSERT(entry.score, -7);
+			GADT_ASSERT(entry.depth, 3);
+			GADT_ASSERT(entry.bound == minimax::MinimaxBound::Lower, true);
+			GADT_ASSERT(entry.best_index, 5);
+			GADT_ASSERT(table.probe(42 + table.size() / minimax::GADT_MINIMAX_TT_BUCKET_SIZE, entry), false);
+			table.clear();
+			GADT_ASSERT(table.probe(42, entry), false);
+
+			Minimax tt_minimax(
+				tic_tac_toe::UpdateState,
+				tic_tac_toe::MakeAction,
+				tic_tac_toe::DetemineWinner,
+				tic_tac_toe::EvaluateState,
+				tic_tac_toe::StateHash
+			);
+			typename Minimax::Setting tt_setting{ timeout, max_depth };
+			tt_setting.transposition_table_size = 1 << 14;
+			action = tt_minimax.RunNegamax(state, tt_setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+			action = tt_minimax.RunAlphabeta(state, tt_setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+			GADT_ASSERT(0, tt_minimax.GetEvalType(state, tt_setting));
+			tt_minimax.ClearTranspositionTable();
+			GADT_ASSERT(0, tt_minimax.GetEvalType(state, tt_setting));
+
+			//iterative deepening.
+			tt_setting.iterative_deepening = true;
+			action = tt_minimax.RunAlphabeta(state, tt_setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+			GADT_ASSERT(tt_minimax.completed_depth(), max_depth);
+			typename Minimax::Setting id_setting{ timeout, max_depth };
+			id_setting.iterative_deepening = true;
+			action = minimax.RunAlphabeta(state, id_setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+			GADT_ASSERT(minimax.completed_depth(), max_depth);
+			id_setting.timeout = 0.000001;
+			minimax.RunAlphabeta(state, id_setting);
+			GADT_ASSERT(minimax.completed_depth() >= 1 && minimax.completed_depth() < max_depth, true);
+
+			//move ordering.
+			minimax::MinimaxMoveOrdering ordering;
+			ordering.init(4);
+			GADT_ASSERT(ordering.killer_slot(2, 7), minimax::GADT_MINIMAX_KILLER_SLOTS);
+			ordering.add_cut(2, 7, 3);
+			ordering.add_cut(2, 8, 1);
+			GADT_ASSERT(ordering.killer_slot(2, 8), 0);
+			GADT_ASSERT(ordering.killer_slot(2, 7), 1);
+			GADT_ASSERT(ordering.killer_slot(1, 7), minimax::GADT_MINIMAX_KILLER_SLOTS);
+			GADT_ASSERT(ordering.history(7), 9);
+			ordering.init(4);
+			GADT_ASSERT(ordering.killer_slot(2, 8), minimax::GADT_MINIMAX_KILLER_SLOTS);
+			GADT_ASSERT(ordering.history(7), 4);
+
+			Minimax ordered_minimax(
+				tic_tac_toe::UpdateState,
+				tic_tac_toe::MakeAction,
+				tic_tac_toe::DetemineWinner,
+				tic_tac_toe::EvaluateState,
+				tic_tac_toe::StateHash,
+				[](const tic_tac_toe::Action& action)->uint64_t { return action.x * 3 + action.y; },
+				[](const tic_tac_toe::State&, const tic_tac_toe::Action& action)->double { return action.x == 1 && action.y == 1 ? 1 : 0; }
+			);
+			typename Minimax::Setting ordered_setting{ timeout, max_depth };
+			ordered_setting.move_ordering = true;
+			action = ordered_minimax.RunAlphabeta(state, ordered_setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+			GADT_ASSERT(0, ordered_minimax.GetEvalType(state, ordered_setting));
+			ordered_setting.transposition_table_size = 1 << 14;
+			ordered_setting.iterative_deepening = true;
+			action = ordered_minimax.RunAlphabeta(state, ordered_setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+			GADT_ASSERT(0, ordered_minimax.GetEvalType(state, ordered_setting));
+			//parallel search.
+			ordered_setting.thread_count = 4;
+			action = ordered_minimax.RunAlphabeta(state, ordered_setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+			GADT_ASSERT(ordered_minimax.completed_depth(), max_depth);
+			GADT_ASSERT(0, ordered_minimax.GetEvalType(state, ordered_setting));
+			ordered_setting.move_ordering = false;
+			ordered_setting.iterative_deepening = false;
+			action = ordered_minimax.RunNegamax(state, ordered_setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+			//principal variation search and aspiration window.
+			for (bool enable_tt : { false, true })
+			{
+				typename Minimax::Setting pvs_setting{ timeout, max_depth };
+				pvs_setting.principal_variation_search = true;
+				pvs_setting.iterative_deepening = true;
+				pvs_setting.aspiration_window = 1;
+				pvs_setting.transposition_table_size = enable_tt ? 1 << 14 : 0;
+				action = ordered_minimax.RunAlphabeta(state, pvs_setting);
+				GADT_ASSERT((action.x == 1 && action.y == 1), true);
+				GADT_ASSERT(0, ordered_minimax.GetEvalType(state, pvs_setting));
+
+				//principal variation starts from the best action and leads to a draw.
+				ordered_minimax.RunAlphabeta(state, pvs_setting);
+				const auto& pv = ordered_minimax.principal_variation();
+				GADT_ASSERT(pv.size() > 0, true);
+				if (pv.size() > 0)
+					GADT_ASSERT((pv[0].x == 1 && pv[0].y == 1), true);
+				if (!enable_tt)
+				{
+					tic_tac_toe::State pv_state = state;
+					for (const auto& pv_action : pv)
+					{
+						GADT_ASSERT(pv_state.dot[pv_action.x][pv_action.y], tic_tac_toe::EMPTY);
+						tic_tac_toe::UpdateState(pv_state, pv_action);
+					}
+					GADT_ASSERT(tic_tac_toe::DetemineWinner(pv_state), tic_tac_toe::DRAW);
+				}
+			}
+
+			//update state in place.
+			Minimax undo_minimax(
+				tic_tac_toe::UpdateState,
+				tic_tac_toe::MakeAction,
+				tic_tac_toe::DetemineWinner,
+				tic_tac_toe::EvaluateState,
+				tic_tac_toe::StateHash,
+				[](const tic_tac_toe::Action& action)->uint64_t { return action.x * 3 + action.y; },
+				nullptr,
+				tic_tac_toe::UndoState
+			);
+			action = undo_minimax.RunNegamax(state, typename Minimax::Setting{ timeout, max_depth });
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+			typename Minimax::Setting undo_setting{ timeout, max_depth };
+			undo_setting.move_ordering = true;
+			undo_setting.principal_variation_search = true;
+			undo_setting.iterative_deepening = true;
+			action = undo_minimax.RunAlphabeta(state, undo_setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+			GADT_ASSERT(0, undo_minimax.GetEvalType(state, undo_setting));
+			undo_setting.transposition_table_size = 1 << 14;
+			undo_setting.thread_count = 4;
+			action = undo_minimax.RunAlphabeta(state, undo_setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
+			GADT_ASSERT(0, undo_minimax.GetEvalType(state, undo_setting));
+		}
+		void TestExpectimax()
+		{
+			using Expectimax = expectimax::ExpectimaxSearch<dice_race::State, dice_race::Action, true>;
+			Expectimax search(
+				dice_race::UpdateState,
+				dice_race::MakeAction,
+				dice_race::DetermineWinner,
+				dice_race::EvaluateState,
+				dice_race::MakeChance
+			);
+			dice_race::State state;
+			state.roll = 1;
+
+			//expected eval computed without any pruning.
+			std::function<double(const dice_race::State&, size_t)> expected = [&](const dice_race::State& state, size_t depth)->double {
+				AgentIndex winner = dice_race::DetermineWinner(state);
+				if (depth == 0 || winner != GADT_DEFAULT_NO_WINNER_INDEX)
+					return dice_race::EvaluateState(state, winner);
+				dice_race::ChanceList chances;
+				dice_race::MakeChance(state, chances);
+				double value = 0;
+				for (const auto& chance : chances)
+				{
+					dice_race::State child = state;
+					dice_race::UpdateState(child, chance.action);
+					value += chance.probability * expected(child, depth);
+				}
+				if (chances.size() > 0)
+					return value;
+				dice_race::ActionSet actions;
+				dice_race::MakeAction(state, actions);
+				value = -INFINITY;
+				for (const auto& action : actions)
+				{
+					dice_race::State child = state;
+					dice_race::UpdateState(child, action);
+					value = std::max(value, -expected(child, depth - 1));
+				}
+				return value;
+			};
+
+			const double bruteforce = expected(state, dice_race::g_TURNS);
+			std::vector<size_t> node_counts;
+			for (auto pruning : { expectimax::ExpectimaxPruning::None, expectimax::ExpectimaxPruning::Star1, expectimax::ExpectimaxPruning::Star2 })
+			{
+				expectimax::ExpectimaxSetting setting(0, GADT_DEFAULT_NO_WINNER_INDEX, dice_race::g_TURNS, 1);
+				setting.pruning = pruning;
+				GADT_ASSERT(fabs(search.GetEvalType(state, setting) - bruteforce) < 1e-9, true);
+				auto action = search.Run(state, setting);
+				GADT_ASSERT(action.choice, 1);
+				node_counts.push_back(search.node_count());
+
+				//eval of shallow search.
+				setting.max_depth = 2;
+				GADT_ASSERT(fabs(search.GetEvalType(state, setting) - expected(state, 2)) < 1e-9, true);
+			}
+			GADT_ASSERT(node_counts[1] < node_counts[0], true);
+			GADT_ASSERT(node_counts[2] < node_counts[1], true);
+
+			//iterative deepening.
+			expectimax::ExpectimaxSetting setting(0, GADT_DEFAULT_NO_WINNER_INDEX, dice_race::g_TURNS + 2, 1);
+			setting.iterative_deepening = true;
+			GADT_ASSERT(fabs(search.GetEvalType(state, setting) - bruteforce) < 1e-9, true);
+			GADT_ASSERT(search.completed_depth(), dice_race::g_TURNS + 2);
 		}
 		void TestRandomPool()
 		{
@@ -913,6 +1643,144 @@ namespace gadt
 			GADT_ASSERT(pool.size(), ub);
 			GADT_ASSERT(pool.random() > 0, true);
 		}
+		void TestThreadPool()
+		{
+			thread::ThreadPool pool(3);
+			GADT_ASSERT(pool.worker_count(), 3);
+			std::vector<size_t> values(1000, 0);
+			pool.ParallelFor(values.size(), [&](size_t i)->void {
+				values[i] = i;
+			});
+			for (size_t i = 0; i < values.size(); i++)
+				GADT_ASSERT(values[i], i);
+
+			//tasks can submit batches to the same pool.
+			std::atomic<size_t> count(0);
+			pool.ParallelFor(8, [&](size_t)->void {
+				pool.ParallelFor(100, [&](size_t)->void {
+					count++;
+				});
+			});
+			GADT_ASSERT(count.load(), 800);
+
+			//pinned workers.
+			pool.enable_affinity();
+			pool.reserve(4);
+			GADT_ASSERT(pool.affinity_enabled(), true);
+			std::atomic<size_t> pinned_count(0);
+			pool.ParallelFor(100, [&](size_t)->void { pinned_count++; });
+			GADT_ASSERT(pinned_count.load(), 100);
+			pool.disable_affinity();
+			GADT_ASSERT(pool.affinity_enabled(), false);
+
+			//the shared pool is reused by searches.
+			thread::SharedPool().reserve(2);
+			GADT_ASSERT(thread::SharedPool().worker_count() >= 2, true);
+
+			//a pool without worker excutes tasks in the calling thread.
+			thread::ThreadPool empty_pool;
+			size_t sum = 0;
+			empty_pool.ParallelFor(10, [&](size_t i)->void { sum += i; });
+			GADT_ASSERT(sum, 45);
+		}
+		void TestRandom()
+		{
+			//same seed leads to same sequence.
+			random::Xoshiro256 fir(42), sec(42);
+			for (size_t i = 0; i < 100; i++)
+				GADT_ASSERT(fir(), sec());
+			random::SeedThread(7);
+			uint64_t first = random::Next();
+			random::SeedThread(7);
+			GADT_ASSERT(random::Next(), first);
+			GADT_ASSERT(random::DeriveSeed(7, 0) != random::DeriveSeed(7, 1), true);
+
+			//bounded number should be in range and cover all values.
+			const size_t range = 7;
+			size_t count[range] = { 0 };
+			for (size_t i = 0; i < 7000; i++)
+			{
+				size_t rnd = random::Bounded(range);
+				GADT_ASSERT(rnd < range, true);
+				if (rnd < range)
+					count[rnd]++;
+			}
+			for (size_t i = 0; i < range; i++)
+				GADT_ASSERT(count[i] > 0, true);
+			GADT_ASSERT(random::Bounded(1), 0);
+			GADT_ASSERT(random::Bounded(uint64_t(1) << 40) < (uint64_t(1) << 40), true);
+			double real = random::Uniform();
+			GADT_ASSERT(real >= 0 && real < 1, true);
+
+			//seeded search is reproducible.
+			mcts::MctsSetting setting;
+			setting.max_iteration_per_thread = 1000;
+			setting.random_seed = 2018;
+			mcts::MonteCarloTreeSearch<tic_tac_toe::State, tic_tac_toe::Action, tic_tac_toe::Result, true> mcts
+			(
+				tic_tac_toe::UpdateState,
+				tic_tac_toe::MakeAction,
+				tic_tac_toe::DetemineWinner,
+				tic_tac_toe::StateToResult,
+				tic_tac_toe::AllowUpdateValue
+			);
+			tic_tac_toe::State state;
+			mcts.EnableTreeReuse();
+
+			//the leaf simulations are seeded by their index, rather than by the workers that run them.
+			for (size_t leaf_simulations : { 1, 4 })
+			{
+				setting.leaf_simulations = leaf_simulations;
+				std::vector<mcts::MctsReward> wins;
+				mcts.Run(state, setting);
+				for (size_t i = 0; i < mcts.tree_root()->child_count(); i++)
+					wins.push_back(mcts.tree_root()->child_node(i)->win_count());
+				mcts.ClearTree();
+				mcts.Run(state, setting);
+				GADT_ASSERT(mcts.tree_root()->child_count(), wins.size());
+				for (size_t i = 0; i < wins.size() && i < mcts.tree_root()->child_count(); i++)
+					GADT_ASSERT(mcts.tree_root()->child_node(i)->win_count(), wins[i]);
+				mcts.ClearTree();
+			}
+			mcts.DisableTreeReuse();
+		}
+		void TestZobrist()
+		{
+			using MnkState = game::MnkGameState<5, 5, 4>;
+
+			//incremental hash equals the hash of whole board.
+			MnkState fir(1), sec(1);
+			GADT_ASSERT(fir.hash(), fir.ComputeHash());
+			fir.TakeAction({ { 0,0 }, 1 });
+			fir.TakeAction({ { 1,1 }, -1 });
+			fir.TakeAction({ { 2,2 }, 1 });
+			GADT_ASSERT(fir.hash(), fir.ComputeHash());
+			GADT_ASSERT(fir.hash() != 0, true);
+
+			//transposed move orders lead to the same hash.
+			sec.TakeAction({ { 2,2 }, 1 });
+			sec.TakeAction({ { 1,1 }, -1 });
+			GADT_ASSERT(sec.hash() != fir.hash(), true);
+			sec.TakeAction({ { 0,0 }, 1 });
+			GADT_ASSERT(sec.hash(), fir.hash());
+
+			//same board with different piece differs.
+			MnkState thr(1);
+			thr.TakeAction({ { 0,0 }, -1 });
+			thr.TakeAction({ { 1,1 }, 1 });
+			thr.TakeAction({ { 2,2 }, 1 });
+			GADT_ASSERT(thr.hash() != fir.hash(), true);
+
+			//toggle twice undo the update.
+			const auto& zobrist = game::ZobristTable<5, 5, 2>::Get();
+			uint64_t hash = fir.hash();
+			zobrist.move_piece(hash, { 0,0 }, { 3,3 }, 0);
+			zobrist.toggle_side(hash);
+			GADT_ASSERT(hash != fir.hash(), true);
+			zobrist.toggle_side(hash);
+			zobrist.move_piece(hash, { 3,3 }, { 0,0 }, 0);
+			GADT_ASSERT(hash, fir.hash());
+		}
 		void TestMonteCarlo()
 		{
 			monte_carlo::MonteCarloSetting setting;
@@ -934,6 +1802,43 @@ namespace gadt
 			//mc.EnableLog();
 			tic_tac_toe::Action action = mc.Run(state, setting);
 			//GADT_ASSERT((action.x == 1 && action.y == 1), true);
+
+			//the statistic of all threads is merged without loss.
+			GADT_ASSERT(mc.simulation_count(), setting.thread_count * (1 + setting.simulation_times));
+			setting.sync_interval = 0;
+			mc.Run(state, setting);
+			GADT_ASSERT(mc.simulation_count(), setting.thread_count * (1 + setting.simulation_times));
+			setting.enable_action_policy = false;
+			mc.Run(state, setting);
+			GADT_ASSERT(mc.simulation_count(), setting.thread_count * (1 + setting.simulation_times / 8) * 8);
+
+			//budget policies, the simulations never exceed the budget and the best move survives the elimination.
+			setting.no_winner_index = tic_tac_toe::EMPTY;
+			for (auto policy : { monte_carlo::MonteCarloBudgetPolicy::SequentialHalving, monte_carlo::MonteCarloBudgetPolicy::SuccessiveRejects })
+			{
+				setting.budget_policy = policy;
+				action = mc.Run(state, setting);
+				GADT_ASSERT((action.x == 1 && action.y == 1), true);
+				GADT_ASSERT(mc.simulation_count() <= setting.thread_count * setting.simulation_times, true);
+				GADT_ASSERT(mc.simulation_count() > setting.thread_count * setting.simulation_times / 2, true);
+			}
+			GADT_ASSERT(monte_carlo::MonteCarloSetting().simulation_times, 10000);
+
+			//truncated simulations, which are evaluated by the owner of center.
+			monte_carlo::MonteCarloFuncPackage<tic_tac_toe::State, tic_tac_toe::Action, tic_tac_toe::Result, true> cutoff_package(
+				tic_tac_toe::UpdateState,
+				tic_tac_toe::MakeAction,
+				tic_tac_toe::DetemineWinner,
+				tic_tac_toe::StateToResult,
+				tic_tac_toe::AllowUpdateValue
+			);
+			cutoff_package.EvaluateRollout = tic_tac_toe::EvaluateRollout;
+			monte_carlo::MonteCarloSimulation<tic_tac_toe::State, tic_tac_toe::Action, tic_tac_toe::Result, true> cutoff_mc(cutoff_package);
+			setting.budget_policy = monte_carlo::MonteCarloBudgetPolicy::None;
+			setting.enable_action_policy = true;
+			setting.simulation_cutoff_length = 1;
+			action = cutoff_mc.Run(state, setting);
+			GADT_ASSERT((action.x == 1 && action.y == 1), true);
 		}
 		void TestDynamicArray()
 		{
@@ -25,12 +25,14 @@
 #include "../src/gadt_game.hpp"
 #include "../src/gadt_container.hpp"
 #include "../src/gadt_memory.hpp"
+#include "../src/gadt_thread.hpp"
 #include "../src/gadt_algorithm.hpp"
 #include "../src/gadt_log.hpp"
 #include "../src/gadt_table.h"
 #include "../src/gadt_filesystem.h"
 #include "../src/monte_carlo.hpp"
 #include "../src/minimax.hpp"
+#include "../src/expectimax.hpp"
 #include "../src/mcts.hpp"
 #include "../src/parallel_mcts.hpp"
 #include "../src/gadt_io.h"
@@ -79,16 +81,78 @@ namespace gadt
 				size_t x;
 				size_t y;
 				Player player;
+
+				inline bool operator==(const Action& action) const
+				{
+					return x == action.x && y == action.y && player == action.player;
+				}
 			};
 
 			using Result = Player;
 			using ActionSet = std::vector<Action>;
 
 			void UpdateState(State& state, const Action& action);
+			void UndoState(State& state, const Action& action);
 			void MakeAction(const State& state, ActionSet& as);
 			Player DetemineWinner(const State& state);
 			Result StateToResult(const State& state, AgentIndex winner);
 			bool AllowUpdateValue(const State& state, Result winner);
+			double EvaluateRollout(const State& state, const State& rollout_state);
+			uint64_t StateHash(const State& state);
+
+			//static policy of mcts, which would be inlined instead of called by std::function.
+			struct MctsPolicy : public mcts::MctsPolicyBase<State, Action, Result, true>
+			{
+				static void UpdateState(State& state, const Action& action) { tic_tac_toe::UpdateState(state, action); }
+				static void MakeAction(const State& state, ActionSet& as) { tic_tac_toe::MakeAction(state, as); }
+				static AgentIndex DetermineWinner(const State& state) { return tic_tac_toe::DetemineWinner(state); }
+				static Result StateToResult(const State& state, AgentIndex winner) { return tic_tac_toe::StateToResult(state, winner); }
+				static bool AllowUpdateValue(const State& state, Result winner) { return tic_tac_toe::AllowUpdateValue(state, winner); }
+				static uint64_t StateHash(const State& state) { return tic_tac_toe::StateHash(state); }
+				static double EvaluateRollout(const State& state, const State& rollout_state) { return tic_tac_toe::EvaluateRollout(state, rollout_state); }
+			};
+		}
+
+		namespace dice_race
+		{
+			//a race game with dice, the dice is rolled before each turn and the player decides how to use it.
+			constexpr size_t g_TURNS = 6;
+
+			struct State
+			{
+				int score[2];
+				int roll;			//0 means the dice is not rolled.
+				size_t turn;
+				AgentIndex next_player;
+
+				State() :
+					score{ 0, 0 },
+					roll(0),
+					turn(0),
+					next_player(0)
+				{
+				}
+			};
+
+			struct Action
+			{
+				int roll;			//roll of dice if it is a chance outcome.
+				int choice;			//0 means gain roll, 1 means gain (4 - roll).
+			};
+
+			using ActionSet = std::vector<Action>;
+			using ChanceList = std::vector<expectimax::ExpectimaxChance<Action>>;
+			using MctsChanceList = std::vector<mcts::MctsChance<Action>>;
+
+			void UpdateState(State& state, const Action& action);
+			void MakeAction(const State& state, ActionSet& as);
+			void MakeChance(const State& state, ChanceList& chances);
+			void ChanceOutcomes(const State& state, MctsChanceList& chances);
+			AgentIndex DetermineWinner(const State& state);
+			double EvaluateState(const State& state, AgentIndex winner);
+			AgentIndex StateToResult(const State& state, AgentIndex winner);
+			bool AllowUpdateValue(const State& state, const AgentIndex& winner);
+			double EvaluateRollout(const State& state, const State& rollout_state);
 		}
 
 		void TestConvertFunc();
@@ -104,12 +168,17 @@ namespace gadt
 		void TestVisualTree ();
 		void TestStlAllocator ();
 		void TestStlLinearAlloc ();
+		void TestStlBlockAlloc ();
 		void TestStlList ();
 		void TestStlStaticMatrix ();
 		void TestStlDynamicMatrix ();
 		void TestTable ();
 		void TestRandomPool ();
+		void TestRandom ();
+		void TestThreadPool ();
+		void TestZobrist ();
 		void TestMinimax ();
+		void TestExpectimax ();
 		void TestMonteCarlo ();
 		void TestDynamicArray ();
 		void TestPodFileIO();
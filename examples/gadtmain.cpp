@@ -73,12 +73,17 @@ void ShellDefine()
 		{ "visual_tree"		,unittest::TestVisualTree		},
 		{ "allocator"		,unittest::TestStlAllocator		},
 		{ "linear_alloc"	,unittest::TestStlLinearAlloc	},
+		{ "block_alloc"		,unittest::TestStlBlockAlloc	},
 		{ "list"			,unittest::TestStlList			},
 		{ "static_matrix"	,unittest::TestStlStaticMatrix	},
 		{ "dynamic_matrix"	,unittest::TestStlDynamicMatrix },
 		{ "table"			,unittest::TestTable			},
 		{ "random_pool"		,unittest::TestRandomPool		},
+		{ "random"			,unittest::TestRandom			},
+		{ "thread_pool"		,unittest::TestThreadPool		},
+		{ "zobrist"			,unittest::TestZobrist			},
 		{ "minimax"			,unittest::TestMinimax			},
+		{ "expectimax"		,unittest::TestExpectimax		},
 		{ "monte_carlo"		,unittest::TestMonteCarlo		},
 		{ "dynamic_array"	,unittest::TestDynamicArray		},
 		{ "pod_io"			,unittest::TestPodFileIO		},
@@ -64,14 +64,17 @@ namespace gadt
 		{
 		private:
 			using Board = stl::StaticMatrix<BtPlayer, g_BT_WIDTH, g_BT_HEIGHT>;
+			using Zobrist = game::ZobristTable<g_BT_WIDTH, g_BT_HEIGHT, 2>;
 
 		private:
 			Board _board;
 			BtPlayer _next_player;
 			size_t _white_piece;
 			size_t _black_piece;
+			uint64_t _hash;
 
 		private:
+			static inline size_t PieceType(BtPlayer piece) { return piece == BLACK ? 0 : 1; }
 
 			inline void init_piece()
 			{
@@ -79,6 +82,7 @@ namespace gadt
 				_board.set_row(1, WHITE);
 				_board.set_row(g_BT_HEIGHT - 1, BLACK);
 				_board.set_row(g_BT_HEIGHT - 2, BLACK);
+				_hash = ComputeHash();
 			}
 
 			inline void reduce_piece(BtPlayer piece)
@@ -95,6 +99,7 @@ namespace gadt
 			BtPlayer next_player() const { return _next_player; }
 			size_t remain_piece(BtPlayer player) const { return player == BLACK ? _black_piece : _white_piece; }
 			BtPlayer piece(UPoint point) const { return _board.element(point); }
+			uint64_t hash() const { return _hash; }
 
 		public:
 
@@ -115,13 +120,31 @@ namespace gadt
 
 			void TakeAction(const BtAction& action)
 			{
+				const Zobrist& zobrist = Zobrist::Get();
 				if (piece(action.dest) != NO_PLAYER)
+				{
+					zobrist.toggle_piece(_hash, action.dest, PieceType(piece(action.dest)));
 					reduce_piece(piece(action.dest));
+				}
+				zobrist.move_piece(_hash, action.source, action.dest, PieceType(piece(action.source)));
+				zobrist.toggle_side(_hash);
 				_board[action.dest] = _board[action.source];
 				_board[action.source] = NO_PLAYER;
 				_next_player = (_next_player == BLACK) ? WHITE : BLACK;
 			}
 
+			//compute hash from the whole board, which is equal to the hash updated by actions.
+			uint64_t ComputeHash() const
+			{
+				uint64_t hash = 0;
+				for (auto point : _board)
+					if (piece(point) != NO_PLAYER)
+						Zobrist::Get().toggle_piece(hash, point, PieceType(piece(point)));
+				if (_next_player == WHITE)
+					Zobrist::Get().toggle_side(hash);
+				return hash;
+			}
+
 			void Print() const
 			{
 				console::Table table(g_BT_WIDTH, g_BT_HEIGHT);
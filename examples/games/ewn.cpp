@@ -61,14 +61,21 @@ namespace gadt
 		{
 			if (action.source != action.dest)
 			{
+				const Zobrist& zobrist = Zobrist::Get();
 				EwnPiece piece = _board[action.source];
-				if(_board[action.dest] >= 0)
+				if (_board[action.dest] >= 0)
+				{
+					zobrist.toggle_piece(_hash, action.dest, (size_t)_board[action.dest]);
 					_piece_flag.reset(_board[action.dest]);
+				}
+				zobrist.move_piece(_hash, action.source, action.dest, (size_t)piece);
+				zobrist.toggle_side(_hash);
 				_board[action.dest] = piece;
 				_piece_point[piece] = action.dest;
 				_board[action.source] = g_EMPTY;
 				_next_player = _next_player == RED ? BLUE : RED;
 			}
+			_hash ^= RollKey(_roll_result) ^ RollKey(action.roll);
 			_roll_result = action.roll;
 		}
 
@@ -103,6 +110,36 @@ namespace gadt
 				_piece_point[i] = red_point[i];
 				_piece_point[i + 6] = blue_point[i];
 			}
+			_hash = ComputeHash();
+		}
+
+		uint64_t EwnState::ComputeHash() const
+		{
+			uint64_t hash = 0;
+			for (auto point : _board)
+				if (_board.element(point) >= 0)
+					Zobrist::Get().toggle_piece(hash, point, (size_t)_board.element(point));
+			if (_next_player == BLUE)
+				Zobrist::Get().toggle_side(hash);
+			hash ^= RollKey(_roll_result);
+			return hash;
+		}
+
+		uint64_t EwnState::RollKey(RollResult roll)
+		{
+			//keys of no roll and roll 0~5, which are generated by another seed than the zobrist table.
+			struct RollKeyTable
+			{
+				uint64_t keys[7];
+				RollKeyTable()
+				{
+					uint64_t seed = game::GADT_ZOBRIST_DEFAULT_SEED ^ 0x6577E;
+					for (size_t i = 0; i < 7; i++)
+						keys[i] = random::SplitMix64(seed);
+				}
+			};
+			static const RollKeyTable table;
+			return table.keys[roll + 1];
 		}
 
 		bool EwnState::IsLegalFormation(Formation formation) const
@@ -201,6 +238,15 @@ namespace gadt
 			action_list = EwnActionGenerator(state).GetAllActions();
 		}
 
+		void ChanceOutcomes(const EwnState & state, EwnChanceList & chances)
+		{
+			if (state.roll_result() == g_EMPTY)
+			{
+				for (RollResult r = 0; r < 6; r++)
+					chances.push_back({ { { 0,0 },{ 0,0 },r }, 1.0 / 6 });
+			}
+		}
+
 		EwnPlayer DetemineWinner(const EwnState & state)
 		{
 			return state.GetWinner();
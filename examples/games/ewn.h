@@ -70,6 +70,7 @@ namespace gadt
 		};
 
 		using EwnActionList = std::vector<EwnAction>;
+		using EwnChanceList = std::vector<mcts::MctsChance<EwnAction>>;
 
 		//state class
 		class EwnState
@@ -77,6 +78,7 @@ namespace gadt
 		private:
 			using EwnBoard = stl::StaticMatrix<EwnPiece, g_WIDTH, g_HEIGHT>;
 			using PieceFlag = bitboard::BitBoard64;
+			using Zobrist = game::ZobristTable<g_WIDTH, g_HEIGHT, 12>;
 
 		private:
 			EwnBoard _board;
@@ -84,6 +86,7 @@ namespace gadt
 			PieceFlag _piece_flag;
 			EwnPlayer _next_player;
 			RollResult _roll_result;
+			uint64_t _hash;
 
 		private:
 			void Init(Formation red, Formation blue);
@@ -92,6 +95,9 @@ namespace gadt
 
 			Formation InputFormation() const;
 
+			//get key of the roll result in the hash, g_EMPTY means the dice is not rolled.
+			static uint64_t RollKey(RollResult roll);
+
 		public:
 			
 			EwnState();
@@ -104,6 +110,9 @@ namespace gadt
 
 			void Print() const;
 
+			//compute hash of pieces, next player and roll result from the whole board, which is equal to the hash updated by actions.
+			uint64_t ComputeHash() const;
+
 			RollResult GetNeighbourPiece(EwnPlayer player, RollResult roll, int step) const
 			{
 				int temp = roll + step;
@@ -116,6 +125,7 @@ namespace gadt
 			inline bool piece_exist(size_t index) const { return _piece_flag[index]; }
 			inline EwnPlayer next_player() const { return _next_player; }
 			inline RollResult roll_result() const { return _roll_result; }
+			inline uint64_t hash() const { return _hash; }
 			inline bool get_player(EwnPiece piece) const 
 			{
 				if (piece == 0 || piece > 12)
@@ -159,6 +169,9 @@ namespace gadt
 
 		void MakeAction(const EwnState& state, EwnActionList& action_list);
 
+		//rolls of dice as the outcomes of chance state, which are the same as the roll actions given by MakeAction.
+		void ChanceOutcomes(const EwnState& state, EwnChanceList& chances);
+
 		EwnPlayer DetemineWinner(const EwnState& state);
 
 		EwnPlayer StateToResult(const EwnState& state, EwnPlayer winner);
@@ -28,20 +28,39 @@ namespace gadt
 {
 	namespace expectimax
 	{
+		using ExpectimaxEvalType = double;
+
+		//the clock is checked once per (mask + 1) nodes when the search can be stopped by timeout.
+		constexpr size_t GADT_EXPECTIMAX_TIMEOUT_CHECK_MASK = 0x3FF;
+
+		//pruning of chance nodes.
+		enum class ExpectimaxPruning : uint8_t
+		{
+			None = 0,	//search all the outcomes with full window.
+			Star1 = 1,	//cut chance node when the bounds of the searched outcomes prove it is out of window.
+			Star2 = 2	//probe the first action of each outcome to get lower bounds before star1 search.
+		};
+
 		/*
-		* MctsSetting is the setting of MCTS.
+		* ExpectimaxSetting is the setting of expectimax search.
 		*
-		* MctsSetting() would use default setting.
-		* MctsSetting(params) would generate custom setting.
+		* ExpectimaxSetting() would use default setting.
+		* ExpectimaxSetting(params) would generate custom setting.
 		*/
 		struct ExpectimaxSetting final : public GameAlgorithmSettingBase
 		{
-			size_t max_depth;					//max depth of search
+			size_t max_depth;					//max depth of search, only decision nodes are counted.
+			double eval_bound;					//evaluation should be in [-eval_bound, eval_bound], which is necessary for pruning.
+			ExpectimaxPruning pruning;			//pruning of chance nodes.
+			bool iterative_deepening;			//search depth 1, 2, 3... until max_depth or timeout.
 
 			//default setting constructor.
 			ExpectimaxSetting() :
 				GameAlgorithmSettingBase(),
-				max_depth(0)
+				max_depth(2),
+				eval_bound(1),
+				pruning(ExpectimaxPruning::Star2),
+				iterative_deepening(false)
 			{
 			}
 
@@ -49,28 +68,512 @@ namespace gadt
 			ExpectimaxSetting(
 				double _timeout,
 				AgentIndex _no_winner_index,
-				size_t _max_depth
+				size_t _max_depth,
+				double _eval_bound = 1
 			) :
 				GameAlgorithmSettingBase(_timeout,_no_winner_index),
-				max_depth(_max_depth)
+				max_depth(_max_depth),
+				eval_bound(_eval_bound),
+				pruning(ExpectimaxPruning::Star2),
+				iterative_deepening(false)
 			{
 			}
 
 			//output print with str behind each line.
-			std::string info() const override
+			void PrintInfo() const override
 			{
-				log::ConsoleTable tb(2, 2);
+				size_t index = 0;
+				console::Table tb(2, 6);
 				tb.set_width({ 12,6 });
 				tb.enable_title({ "EXPECTIMAX SETTING" });
-				tb.set_cell_in_row(0, { { "timeout" },{ ToString(timeout) } });
-				tb.set_cell_in_row(1, { { "depth" },{ ToString(max_depth) } });
-				return tb.output_string();
+				tb.set_cell_in_row(index++, { { "timeout" },{ ToString(timeout) } });
+				tb.set_cell_in_row(index++, { { "max_depth" },{ ToString(max_depth) } });
+				tb.set_cell_in_row(index++, { { "no_winner_index" },{ ToString(no_winner_index) } });
+				tb.set_cell_in_row(index++, { { "eval_bound" },{ ToString(eval_bound) } });
+				tb.set_cell_in_row(index++, { { "pruning" },{ ToString(static_cast<int>(pruning)) } });
+				tb.set_cell_in_row(index++, { { "iterative_deepening" },{ ToString(iterative_deepening) } });
+				tb.Print();
+			}
+		};
+
+		//outcome of chance node, such as a result of dice.
+		template<typename Action>
+		struct ExpectimaxChance
+		{
+			Action action;		//action applied to state by UpdateState.
+			double probability;	//probability of the outcome.
+		};
+
+		/*
+		* ExpectimaxFuncPackage include all necessary functions for expectimax search.
+		*
+		* MakeChance gives the outcomes of a chance state, and gives nothing if the state is a decision state.
+		* outcomes are applied by UpdateState and should not change the player to move.
+		* EvaluateState gives the eval for the player to move, which should be in the bound of setting.
+		*/
+		template<typename State, typename Action, bool _is_debug>
+		struct ExpectimaxFuncPackage final : public GameAlgorithmFuncPackageBase<State, Action, _is_debug>
+		{
+		public:
+#ifdef __GADT_GNUC
+			using ActionList = typename GameAlgorithmFuncPackageBase<State, Action, _is_debug>::ActionList;
+			using UpdateStateFunc = typename GameAlgorithmFuncPackageBase<State, Action, _is_debug>::UpdateStateFunc;
+			using MakeActionFunc = typename GameAlgorithmFuncPackageBase<State, Action, _is_debug>::MakeActionFunc;
+			using DetermineWinnerFunc = typename GameAlgorithmFuncPackageBase<State, Action, _is_debug>::DetermineWinnerFunc;
+			using GameAlgorithmFuncPackageBase<State, Action, _is_debug>::is_debug;
+#else 
+			using GameAlgorithmFuncPackageBase<State, Action, _is_debug>::ActionList;
+			using GameAlgorithmFuncPackageBase<State, Action, _is_debug>::UpdateStateFunc;
+			using GameAlgorithmFuncPackageBase<State, Action, _is_debug>::MakeActionFunc;
+			using GameAlgorithmFuncPackageBase<State, Action, _is_debug>::DetermineWinnerFunc;
+#endif
+			using ChanceList = std::vector<ExpectimaxChance<Action>>;
+			using EvaluateStateFunc = std::function<ExpectimaxEvalType(const State&, const AgentIndex)>;
+			using MakeChanceFunc = std::function<void(const State&, ChanceList&)>;
+
+		public:
+			const EvaluateStateFunc		EvaluateState;		//get the eval for the player to move.
+			const MakeChanceFunc		MakeChance;			//get the outcomes of chance state.
+
+		public:
+			ExpectimaxFuncPackage(
+				UpdateStateFunc			_UpdateState,
+				MakeActionFunc			_MakeAction,
+				DetermineWinnerFunc		_DetermineWinner,
+				EvaluateStateFunc		_EvaluateState,
+				MakeChanceFunc			_MakeChance
+			) :
+				GameAlgorithmFuncPackageBase<State, Action, _is_debug>(_UpdateState, _MakeAction, _DetermineWinner),
+				EvaluateState(_EvaluateState),
+				MakeChance(_MakeChance)
+			{
 			}
 		};
 
+		/*
+		* ExpectimaxNode is the node class in the expectimax search, which is either a decision node or a chance node.
+		*
+		* [State] is the game-state class, which is defined by the user.
+		* [Action] is the game-action class, which is defined by the user.
+		* [is_debug] means some debug info would not be ignored if it is true. this may result in a little degradation of performance.
+		*/
+		template<typename State, typename Action, bool _is_debug>
 		class ExpectimaxNode
 		{
+		public:
+			using FuncPackage	= ExpectimaxFuncPackage<State, Action, _is_debug>;
+			using Setting		= ExpectimaxSetting;
+			using ActionList	= typename FuncPackage::ActionList;
+			using ChanceList	= typename FuncPackage::ChanceList;
+
+		private:
+			State				_state;			//game state
+			size_t				_depth;			//remain depth of decision nodes.
+			ActionList			_action_list;	//action set, which is generated when the node is expanded.
+			ChanceList			_chance_list;	//outcomes if it is a chance node.
+			AgentIndex			_winner;		//winner of the node.
+
+		public:
+			ExpectimaxNode(const State& state, size_t depth, const FuncPackage& func_package, const Setting& setting) :
+				_state(state),
+				_depth(depth),
+				_action_list(),
+				_chance_list(),
+				_winner(func_package.DetermineWinner(state))
+			{
+				if (_winner == setting.no_winner_index)
+					func_package.MakeChance(_state, _chance_list);
+			}
+
+			//generate the action set of the node.
+			inline void MakeAction(const FuncPackage& func_package)
+			{
+				if (_action_list.size() == 0)
+					func_package.MakeAction(_state, _action_list);
+			}
+
+			inline const State& state() const { return _state; }
+			inline size_t depth() const { return _depth; }
+			inline AgentIndex winner() const { return _winner; }
+			inline size_t action_count() const { return _action_list.size(); }
+			inline const Action& action(size_t index) const { return _action_list[index]; }
+			inline const ActionList& action_list() const { return _action_list; }
+			inline const ChanceList& chance_list() const { return _chance_list; }
+
+			//return true if the node is a chance node.
+			inline bool is_chance() const
+			{
+				return _chance_list.size() > 0;
+			}
+
+			//return true if the node is terminal.
+			inline bool is_terminal_state(const Setting& setting) const
+			{
+				return _winner != setting.no_winner_index;
+			}
+		};
+
+		/*
+		* ExpectimaxSearch is a template of expectimax search in negamax form, for games with chance like dice.
+		*
+		* chance nodes are pruned by star1 and star2 with the bound of evaluation in setting.
+		*
+		* [State] is the game-state class, which is defined by the user.
+		* [Action] is the game-action class, which is defined by the user.
+		* [_is_debug] means some debug info would not be ignored if it is true. this may result in a little degradation of performance.
+		*/
+		template<typename State, typename Action, bool _is_debug = false>
+		class ExpectimaxSearch final : public GameAlgorithmBase<State, Action, AgentIndex, _is_debug>
+		{
+		private:
+			using GameAlgorithmBase<State, Action, AgentIndex, _is_debug>::_log_controller;
+			using GameAlgorithmBase<State, Action, AgentIndex, _is_debug>::logger;
+			using GameAlgorithmBase<State, Action, AgentIndex, _is_debug>::log_enabled;
+			using GameAlgorithmBase<State, Action, AgentIndex, _is_debug>::timeout;
+			using GameAlgorithmBase<State, Action, AgentIndex, _is_debug>::is_debug;
+
+		public:
+			using GameAlgorithmBase<State, Action, AgentIndex, _is_debug>::name;
+			using GameAlgorithmBase<State, Action, AgentIndex, _is_debug>::set_name;
+			using GameAlgorithmBase<State, Action, AgentIndex, _is_debug>::InitLog;
+			using GameAlgorithmBase<State, Action, AgentIndex, _is_debug>::EnableLog;
+			using GameAlgorithmBase<State, Action, AgentIndex, _is_debug>::DisableLog;
+
+		public:
+			using EvalType		= ExpectimaxEvalType;
+			using Node			= ExpectimaxNode<State, Action, _is_debug>;
+			using FuncPackage	= typename Node::FuncPackage;
+			using Setting		= typename Node::Setting;
+			using ActionList	= typename FuncPackage::ActionList;
+			using ChanceList	= typename FuncPackage::ChanceList;
+
+		private:
+			FuncPackage			_func_package;
+			Setting				_setting;
+			timer::TimePoint	_search_start;		//time point when the search started.
+			bool				_allow_stop;		//the search can be stopped by timeout once an iteration is completed.
+			bool				_search_stopped;	//the search is stopped by timeout, and the results of the iteration are discarded.
+			size_t				_node_count;		//count of visited nodes in last search.
+			size_t				_completed_depth;	//depth of the deepest completed iteration.
+
+		private:
+			inline EvalType upper_bound() const { return static_cast<EvalType>(_setting.eval_bound); }
+			inline EvalType lower_bound() const { return -static_cast<EvalType>(_setting.eval_bound); }
 
+			//get the eval of a node with window, the result is from the view of the player to move.
+			EvalType EvaluateNode(Node& node, EvalType alpha, EvalType beta)
+			{
+				_node_count++;
+				if (_allow_stop && (_node_count & GADT_EXPECTIMAX_TIMEOUT_CHECK_MASK) == 0 && timeout(_search_start, _setting.timeout))
+					_search_stopped = true;
+				if (_search_stopped)
+					return alpha;
+
+				if (node.depth() == 0 || node.is_terminal_state(_setting))
+				{
+					EvalType eval = _func_package.EvaluateState(node.state(), node.winner());
+					GADT_WARNING_IF(is_debug(), (eval > upper_bound() || eval < lower_bound()), "EX101: eval is out of the bound in setting.");
+					return eval > upper_bound() ? upper_bound() : (eval < lower_bound() ? lower_bound() : eval);
+				}
+				if (node.is_chance())
+					return EvaluateChanceNode(node, alpha, beta);
+				return EvaluateDecisionNode(node, alpha, beta);
+			}
+
+			//get the eval of decision node by alpha-beta, the first action is skipped if its exact eval is probed.
+			EvalType EvaluateDecisionNode(Node& node, EvalType alpha, EvalType beta, const EvalType* probed_first = nullptr)
+			{
+				node.MakeAction(_func_package);
+				GADT_WARNING_IF(is_debug(), node.action_count() == 0, "EX102: empty action set");
+				EvalType best_value = alpha;
+				size_t first = 0;
+				if (probed_first != nullptr && node.action_count() > 0)
+				{
+					if (*probed_first >= beta)
+						return beta;//prune!
+					if (*probed_first > best_value)
+						best_value = *probed_first;
+					first = 1;
+				}
+				for (size_t i = first; i < node.action_count(); i++)
+				{
+					State child_state = node.state();
+					_func_package.UpdateState(child_state, node.action(i));
+					Node child(child_state, node.depth() - 1, _func_package, _setting);
+					EvalType child_value = -EvaluateNode(child, -beta, -best_value);
+					if (_search_stopped)
+						return alpha;
+					if (child_value >= beta)
+						return beta;//prune!
+					if (child_value > best_value)
+						best_value = child_value;
+				}
+				return best_value;
+			}
+
+			//get a lower bound of decision node by searching its first action only, which is the probe of star2.
+			EvalType ProbeDecisionNode(Node& node, EvalType beta)
+			{
+				node.MakeAction(_func_package);
+				if (node.action_count() == 0)
+					return lower_bound();
+				State child_state = node.state();
+				_func_package.UpdateState(child_state, node.action(0));
+				Node child(child_state, node.depth() - 1, _func_package, _setting);
+				return -EvaluateNode(child, -beta, upper_bound());
+			}
+
+			//get the eval of a probed decision node, whose first action is not searched again.
+			EvalType EvaluateProbedNode(Node& node, EvalType alpha, EvalType beta, EvalType probed_first)
+			{
+				_node_count++;
+				if (_search_stopped)
+					return alpha;
+				return EvaluateDecisionNode(node, alpha, beta, &probed_first);
+			}
+
+			//get the eval of chance node, which is the expected eval of all outcomes.
+			EvalType EvaluateChanceNode(Node& node, EvalType alpha, EvalType beta)
+			{
+				const ChanceList& chances = node.chance_list();
+				std::vector<Node> children;
+				children.reserve(chances.size());
+				double total_probability = 0;
+				for (const auto& chance : chances)
+				{
+					State child_state = node.state();
+					_func_package.UpdateState(child_state, chance.action);
+					children.emplace_back(child_state, node.depth(), _func_package, _setting);
+					total_probability += chance.probability;
+				}
+				GADT_WARNING_IF(is_debug(), (total_probability < 0.999999 || total_probability > 1.000001), "EX103: total probability of chance node is not 1.");
+
+				//without pruning, all the outcomes are searched with full window.
+				if (_setting.pruning == ExpectimaxPruning::None)
+				{
+					EvalType expected = 0;
+					for (size_t i = 0; i < children.size(); i++)
+					{
+						expected += chances[i].probability * EvaluateNode(children[i], lower_bound(), upper_bound());
+						if (_search_stopped)
+							return alpha;
+					}
+					return expected;
+				}
+
+				//star2, probe each outcome to get its lower bound, cut if the sum of lower bounds reaches beta.
+				//the probed eval is exact if it is below the probe beta, which would be reused by the full search.
+				std::vector<EvalType> lower_bounds(children.size(), lower_bound());
+				std::vector<bool> probe_exact(children.size(), false);
+				if (_setting.pruning == ExpectimaxPruning::Star2)
+				{
+					EvalType probed = lower_bound() * total_probability;
+					for (size_t i = 0; i < children.size(); i++)
+					{
+						const double probability = chances[i].probability;
+						Node& child = children[i];
+						if (probability <= 0 || child.is_chance() || child.depth() == 0 || child.is_terminal_state(_setting))
+							continue;
+						const EvalType probe_beta = (beta - probed + probability * lower_bound()) / probability;
+						const EvalType bounded_probe_beta = probe_beta < upper_bound() ? probe_beta : upper_bound();
+						lower_bounds[i] = ProbeDecisionNode(child, bounded_probe_beta);
+						if (_search_stopped)
+							return alpha;
+						probe_exact[i] = lower_bounds[i] < bounded_probe_beta;
+						probed += probability * (lower_bounds[i] - lower_bound());
+						if (probed >= beta)
+							return beta;//prune!
+					}
+				}
+
+				//star1, search each outcome with the window that would decide whether the chance node is out of window.
+				EvalType searched = 0;
+				double remain_probability = total_probability;
+				EvalType remain_lower = 0;
+				for (size_t i = 0; i < children.size(); i++)
+					remain_lower += chances[i].probability * lower_bounds[i];
+				for (size_t i = 0; i < children.size(); i++)
+				{
+					const double probability = chances[i].probability;
+					remain_probability -= probability;
+					remain_lower -= probability * lower_bounds[i];
+					if (probability <= 0)
+						continue;
+					const EvalType child_alpha = (alpha - searched - upper_bound() * remain_probability) / probability;
+					const EvalType child_beta = (beta - searched - remain_lower) / probability;
+					if (child_alpha >= upper_bound())
+						return alpha;//prune!
+					if (child_beta <= lower_bound())
+						return beta;//prune!
+					const EvalType window_alpha = child_alpha > lower_bound() ? child_alpha : lower_bound();
+					const EvalType window_beta = child_beta < upper_bound() ? child_beta : upper_bound();
+					EvalType child_value = probe_exact[i] ?
+						EvaluateProbedNode(children[i], window_alpha, window_beta, lower_bounds[i]) :
+						EvaluateNode(children[i], window_alpha, window_beta);
+					if (_search_stopped)
+						return alpha;
+					if (child_value <= child_alpha)
+						return alpha;//prune!
+					if (child_value >= child_beta)
+						return beta;//prune!
+					searched += probability * child_value;
+				}
+				return searched;
+			}
+
+			//search all the child nodes of root with appointed depth, return false if the search is stopped by timeout.
+			bool SearchRootChildren(const Node& root, size_t depth, size_t first_index, std::vector<EvalType>& eval_set, size_t& best_action_index, EvalType& best_value)
+			{
+				best_value = -INFINITY;
+				best_action_index = first_index;
+				for (size_t n = 0; n < root.action_count(); n++)
+				{
+					//the best action of previous iteration is searched first.
+					const size_t i = n == 0 ? first_index : (n <= first_index ? n - 1 : n);
+					State child_state = root.state();
+					_func_package.UpdateState(child_state, root.action(i));
+					Node child(child_state, depth - 1, _func_package, _setting);
+					const EvalType root_alpha = best_value > lower_bound() ? best_value : lower_bound();
+					eval_set[i] = -EvaluateNode(child, -upper_bound(), -root_alpha);
+					if (_search_stopped)
+						return false;
+					if (eval_set[i] > best_value)
+					{
+						best_action_index = i;
+						best_value = eval_set[i];
+					}
+				}
+				return true;
+			}
+
+			//start expectimax search.
+			std::pair<Action, EvalType> StartExpectimaxIteration(const State& state, Setting setting, bool return_when_single_move)
+			{
+				_setting = setting;
+				_search_start.reset();
+				_allow_stop = false;
+				_search_stopped = false;
+				_node_count = 0;
+				_completed_depth = 0;
+				Node root(state, _setting.max_depth, _func_package, _setting);
+				root.MakeAction(_func_package);
+
+				GADT_WARNING_IF(is_debug(), root.is_terminal_state(_setting), "EX104: execute search for terminal state.");
+				GADT_WARNING_IF(is_debug(), root.is_chance(), "EX105: execute search for chance state.");
+				GADT_WARNING_IF(is_debug(), _setting.eval_bound <= 0, "EX106: eval bound should be positive.");
+
+				if (log_enabled())
+				{
+					logger() << "[ Expectimax Search ]" << std::endl;
+					_setting.PrintInfo();
+					logger() << std::endl << ">> Executing Expectimax Search......" << std::endl;
+				}
+
+				//return action if there is only one action in root node.
+				if (root.action_count() == 1 && return_when_single_move)
+				{
+					if (log_enabled())
+					{
+						logger() << ">> Only one action is available. action = " << _log_controller.action_to_str_func()(root.action(0)) << std::endl;
+					}
+					return { root.action(0), EvalType() };
+				}
+
+				std::vector<EvalType> eval_set(root.action_count(), EvalType());
+				std::vector<EvalType> iteration_eval_set(root.action_count(), EvalType());
+				EvalType best_value = lower_bound();
+				size_t best_action_index = 0;
+
+				//search depth 1, 2, 3... until max depth or timeout if iterative deepening is enabled.
+				const size_t max_depth = _setting.max_depth > 0 ? _setting.max_depth : 1;
+				const size_t first_depth = _setting.iterative_deepening ? 1 : max_depth;
+				for (size_t depth = first_depth; depth <= max_depth; depth++)
+				{
+					size_t iteration_best_index = 0;
+					EvalType iteration_best_value;
+					if (!SearchRootChildren(root, depth, best_action_index, iteration_eval_set, iteration_best_index, iteration_best_value))
+						break;
+					eval_set = iteration_eval_set;
+					best_action_index = iteration_best_index;
+					best_value = iteration_best_value;
+					_completed_depth = depth;
+					_allow_stop = _setting.iterative_deepening;
+					if (log_enabled() && _setting.iterative_deepening)
+					{
+						logger() << ">> depth = " << depth
+							<< ", best action = " << _log_controller.action_to_str_func()(root.action(best_action_index))
+							<< ", eval = " << ToString(best_value)
+							<< ", time = " << _search_start.time_since_created() << "s" << std::endl;
+					}
+					if (timeout(_search_start, _setting.timeout))
+						break;
+				}
+
+				if (log_enabled())
+				{
+					console::Table tb(4, root.action_count() + 1);
+					tb.enable_title({ "EXPECTIMAX RESULT" });
+					tb.set_cell_in_row(0, { { "Index" },{ "Action" },{ "Eval" },{ "Is Best" } });
+					tb.set_width({ 3,10,4,4 });
+					for (size_t i = 0; i < root.action_count(); i++)
+					{
+						tb.set_cell_in_row(i + 1, {
+							{ ToString(i) },
+							{ _log_controller.action_to_str_func()(root.action(i)) },
+							{ ToString(eval_set[i]) },
+							{ i == best_action_index ? "Yes " : "  " }
+							});
+					}
+					tb.Print();
+				}
+
+				//return best action.
+				return { root.action(best_action_index), best_value };
+			}
+
+		public:
+			//constructor func.
+			ExpectimaxSearch(
+				typename FuncPackage::UpdateStateFunc		UpdateState,
+				typename FuncPackage::MakeActionFunc		MakeAction,
+				typename FuncPackage::DetermineWinnerFunc	DetermineWinner,
+				typename FuncPackage::EvaluateStateFunc		EvaluateState,
+				typename FuncPackage::MakeChanceFunc		MakeChance
+			) :
+				GameAlgorithmBase<State, Action, AgentIndex, _is_debug>("Expectimax"),
+				_func_package(UpdateState, MakeAction, DetermineWinner, EvaluateState, MakeChance),
+				_setting(),
+				_search_start(),
+				_allow_stop(false),
+				_search_stopped(false),
+				_node_count(0),
+				_completed_depth(0)
+			{
+			}
+
+			//get the count of visited nodes in last search.
+			inline size_t node_count() const
+			{
+				return _node_count;
+			}
+
+			//get the depth of the deepest completed iteration in last search.
+			inline size_t completed_depth() const
+			{
+				return _completed_depth;
+			}
+
+			//excute expectimax search.
+			Action Run(const State& state, Setting setting = Setting())
+			{
+				return StartExpectimaxIteration(state, setting, true).first;
+			}
+
+			//get the expected eval of the state.
+			EvalType GetEvalType(const State& state, Setting setting = Setting())
+			{
+				return StartExpectimaxIteration(state, setting, false).second;
+			}
 		};
 	}
-}
\ No newline at end of file
+}
@@ -41,11 +41,14 @@
 	#include <errno.h> 
 	#include <unistd.h>
 	#include <dirent.h>
+	#include <pthread.h>
+	#include <sched.h>
 #else
 	#error "unsupported compiler, please check complier or delete this error in 'gadt_config.h'"
 #endif
 
 #include <cstdio>
+#include <cmath>
 #include <stdlib.h>
 #include <math.h>
 #include <stdio.h>
@@ -63,6 +66,10 @@
 #include <queue>
 #include <memory>
 #include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <algorithm>
 #include <type_traits>
@@ -82,4 +89,7 @@ namespace gadt
 	constexpr bool GADT_TABLE_ENABLE_WARNING		= true;	//enable warning in module 'table'.
 	constexpr bool GADT_SHELL_ENABLE_WARNING		= true;	//enable warning in module 'shell'.
 	constexpr bool GADT_VISUAL_TREE_ENABLE_WARNING	= true; //enable warning in module 'visual_tree'
+	constexpr bool GADT_THREAD_ENABLE_WARNING		= true;	//enable warning in module 'thread'.
+
+	constexpr size_t GADT_CACHE_LINE_SIZE			= 64;	//size of cache line, which is used to align data shared by threads.
 }
\ No newline at end of file
@@ -1274,7 +1274,7 @@ namespace gadt
 			inline const reference random() const
 			{
 				GADT_WARNING_IF(GADT_STL_ENABLE_WARNING, size() == 0, "random pool is empty.");
-				size_t rnd = rand() % _accumulated_range;
+				size_t rnd = random::Bounded(_accumulated_range);
 				for (size_t i = 0; i < size(); i++)
 				{
 					if (rnd >= _ele_alloc[i]->left && rnd < _ele_alloc[i]->right)
@@ -1707,7 +1707,7 @@ namespace gadt
 			T random_pop()
 			{
 				GADT_WARNING_IF(GADT_STL_ENABLE_WARNING, is_empty(), "overflow");
-				size_t rnd = rand() % size();
+				size_t rnd = random::Bounded(size());
 				T temp = _elements[rnd];
 				_elements.swap(rnd, size() - 1);
 				_elements.pop_back();
@@ -1718,7 +1718,7 @@ namespace gadt
 			T random() const
 			{
 				GADT_WARNING_IF(GADT_STL_ENABLE_WARNING, is_empty(), "overflow");
-				size_t rnd = rand() % size();
+				size_t rnd = random::Bounded(size());
 				return _elements.const_element(rnd);
 			}
 
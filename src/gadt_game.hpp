@@ -88,6 +88,73 @@ namespace gadt
 
 	namespace game
 	{
+		//default seed of the keys in zobrist table, keys are fixed so that hash values are stable between runs.
+		constexpr uint64_t GADT_ZOBRIST_DEFAULT_SEED = 0x5A0B7A15C0FFEE11ULL;
+
+		/*
+		* ZobristTable is a table of random keys for zobrist hashing of board games.
+		*
+		* there is a key for each piece type at each point of the board, and a key for the side to move.
+		* the hash of a state is the xor of the keys of all the pieces in the board, so that it can be updated
+		* in O(1) when a piece is placed, removed or moved. since xor is self-inverse, the same call undoes the update.
+		*
+		* [_WIDTH] and [_HEIGHT] are the size of the board, [_PIECE_TYPES] is the number of piece types.
+		*/
+		template<size_t _WIDTH, size_t _HEIGHT, size_t _PIECE_TYPES>
+		class ZobristTable
+		{
+		private:
+			uint64_t _piece_key[_WIDTH * _HEIGHT][_PIECE_TYPES];
+			uint64_t _side_key;
+
+			ZobristTable(uint64_t seed)
+			{
+				for (size_t i = 0; i < _WIDTH * _HEIGHT; i++)
+					for (size_t n = 0; n < _PIECE_TYPES; n++)
+						_piece_key[i][n] = random::SplitMix64(seed);
+				_side_key = random::SplitMix64(seed);
+			}
+
+		public:
+			//get the shared table of this board size.
+			static const ZobristTable& Get()
+			{
+				static const ZobristTable table(GADT_ZOBRIST_DEFAULT_SEED);
+				return table;
+			}
+
+			//get key of the piece type at point.
+			inline uint64_t piece_key(UPoint point, size_t piece_type) const
+			{
+				GADT_WARNING_IF(GADT_STL_ENABLE_WARNING, (point.x >= _WIDTH || point.y >= _HEIGHT || piece_type >= _PIECE_TYPES), "ZB001: out of zobrist table range.");
+				return _piece_key[point.y * _WIDTH + point.x][piece_type];
+			}
+
+			//get key of the side to move.
+			inline uint64_t side_key() const
+			{
+				return _side_key;
+			}
+
+			//place or remove a piece in the hash.
+			inline void toggle_piece(uint64_t& hash, UPoint point, size_t piece_type) const
+			{
+				hash ^= piece_key(point, piece_type);
+			}
+
+			//move a piece from source to dest in the hash.
+			inline void move_piece(uint64_t& hash, UPoint source, UPoint dest, size_t piece_type) const
+			{
+				hash ^= piece_key(source, piece_type) ^ piece_key(dest, piece_type);
+			}
+
+			//switch the side to move in the hash.
+			inline void toggle_side(uint64_t& hash) const
+			{
+				hash ^= _side_key;
+			}
+		};
+
 		//define action of mnk game.
 		struct MnkGameAction
 		{
@@ -122,8 +189,13 @@ namespace gadt
 			AgentIndex _winner;
 			AgentIndex _next_player;
 			size_t _piece_count;
+			uint64_t _hash;
 
 		private:
+			using Zobrist = ZobristTable<_WIDTH, _HEIGHT, 2>;
+
+			static inline size_t PieceType(AgentIndex piece) { return piece > 0 ? 0 : 1; }
+
 			void SetActionRange(const UPoint& point)
 			{
 				for (int i = 1; i <= _ACTION_RANGE; i++)
@@ -147,6 +219,7 @@ namespace gadt
 			inline AgentIndex piece(UPoint point) const { return _piece.element(point); }
 			inline AgentIndex winner() const { return _winner; }
 			inline AgentIndex next_player() const { return _next_player; }
+			inline uint64_t hash() const { return _hash; }
 			inline bool is_empty()
 			{
 				for (auto point : _piece)
@@ -172,7 +245,8 @@ namespace gadt
 				_action_range(false),
 				_winner(0),
 				_next_player(first_player),
-				_piece_count(0)
+				_piece_count(0),
+				_hash(0)
 			{
 			}
 
@@ -190,6 +264,20 @@ namespace gadt
 				_action_range.set_element(false, action.point);
 				_piece_count++;
 				SetActionRange(action.point);
+				Zobrist::Get().toggle_piece(_hash, action.point, PieceType(action.piece));
+				Zobrist::Get().toggle_side(_hash);
+			}
+
+			//compute hash from the whole board, which is equal to the hash updated by actions.
+			uint64_t ComputeHash() const
+			{
+				uint64_t hash = 0;
+				for (auto point : _piece)
+					if (piece(point) != 0)
+						Zobrist::Get().toggle_piece(hash, point, PieceType(piece(point)));
+				if (_piece_count % 2 != 0)
+					Zobrist::Get().toggle_side(hash);
+				return hash;
 			}
 
 			AgentIndex JudgeWinnerFromPiece(const UPoint& point)
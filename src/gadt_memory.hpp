@@ -417,6 +417,297 @@ namespace gadt
 			{
 				return element(index);
 			}
-		};		
+		};
+
+		/*
+		* BlockAllocator is a memory allocator, whose memory is preallocate at the time when the object is created.
+		* it allocates blocks of contiguous elements. the elements in a block are constructed and destoryed by the owner 
+		* of the block, the allocator only manages memory. adjacent deallocated blocks are merged, they would be reused 
+		* by the blocks with same size first, and larger ones would be split if the preallocated memory is run out.
+		*
+		* [T] is the class type.
+		* [is_debug] means some debug info would not be ignored if it is true. this may result in a little degradation of performance.
+		*/
+		template<typename T, bool _is_debug = false>
+		class BlockAllocator final
+		{
+		private:
+			using pointer = T*;
+			using reference = T&;
+			using free_block_set = std::set<std::pair<size_t, size_t>>;
+			using free_block_map = std::map<size_t, size_t>;
+
+			static const size_t		_size = sizeof(T);
+			const size_t			_count;
+			pointer					_fir_element;
+			size_t					_length;			//count of elements that had been used by blocks.
+			size_t					_free_size;			//count of elements in deallocated blocks.
+			free_block_set			_free_by_size;		//deallocated blocks as pair of size and index, sorted by size.
+			free_block_map			_free_by_index;		//size of deallocated blocks, sorted by index.
+
+		private:
+			//allocate memory
+			inline void alloc_memory(size_t count)
+			{
+				_fir_element = reinterpret_cast<T*>(calloc(count, _size));
+			}
+
+			//delete memory
+			inline void delete_memory()
+			{
+				::free(_fir_element);
+				_fir_element = nullptr;
+				_length = 0;
+			}
+
+			//get index by pointer.
+			inline size_t ptr_to_index(pointer p) const
+			{
+				return static_cast<size_t>(p - _fir_element);
+			}
+
+			//add a deallocated block.
+			inline void insert_free_block(size_t index, size_t count)
+			{
+				_free_by_size.insert({ count, index });
+				_free_by_index[index] = count;
+				_free_size += count;
+			}
+
+			//remove a deallocated block.
+			inline void erase_free_block(size_t index, size_t count)
+			{
+				_free_by_size.erase({ count, index });
+				_free_by_index.erase(index);
+				_free_size -= count;
+			}
+
+			//return the value of _is_debug.
+			constexpr inline bool is_debug() const
+			{
+				return _is_debug;
+			}
+
+		public:
+			//constructor function with allocation.
+			BlockAllocator(size_t count) :
+				_count(count),
+				_fir_element(nullptr),
+				_length(0),
+				_free_size(0),
+				_free_by_size(),
+				_free_by_index()
+			{
+				alloc_memory(count);
+			}
+
+			//copy constructor is banned because the allocator do not know which elements are constructed.
+			BlockAllocator(const BlockAllocator&) = delete;
+
+			//destructor function.
+			~BlockAllocator()
+			{
+				delete_memory();
+			}
+
+			//allocate a block with appointed count of elements, return nullptr if there are not available space.
+			pointer allocate(size_t count)
+			{
+				if (count == 0)
+					return nullptr;
+
+				//reuse deallocated block with same size, or allocate from the preallocated memory.
+				auto iter = _free_by_size.lower_bound({ count, 0 });
+				bool exact = iter != _free_by_size.end() && iter->first == count;
+				if (!exact && _count - _length >= count)
+				{
+					pointer block = _fir_element + _length;
+					_length += count;
+					return block;
+				}
+
+				//split the smallest larger block if there is no space left.
+				if (iter == _free_by_size.end())
+					return nullptr;
+				size_t block_size = iter->first;
+				size_t index = iter->second;
+				erase_free_block(index, block_size);
+				if (block_size > count)
+					insert_free_block(index + count, block_size - count);
+				return _fir_element + index;
+			}
+
+			//deallocate a block, all the elements in it should had been destoryed. return true if deallocate successfully.
+			bool deallocate(pointer block, size_t count)
+			{
+				uintptr_t t = uintptr_t(block);
+				uintptr_t fir = uintptr_t(_fir_element);
+				uintptr_t last = uintptr_t(_fir_element + _length);
+				if (block != nullptr && count > 0 && t >= fir && t + count * _size <= last && ((t - fir) % _size == 0))
+				{
+					size_t index = ptr_to_index(block);
+
+					//merge with the next deallocated block.
+					auto next = _free_by_index.find(index + count);
+					if (next != _free_by_index.end())
+					{
+						size_t next_index = next->first;
+						size_t next_count = next->second;
+						erase_free_block(next_index, next_count);
+						count += next_count;
+					}
+
+					//merge with the previous deallocated block.
+					auto prev = _free_by_index.lower_bound(index);
+					if (prev != _free_by_index.begin())
+					{
+						--prev;
+						if (prev->first + prev->second == index)
+						{
+							size_t prev_index = prev->first;
+							size_t prev_count = prev->second;
+							erase_free_block(prev_index, prev_count);
+							index = prev_index;
+							count += prev_count;
+						}
+					}
+
+					//the last block is returned to the preallocated memory.
+					if (index + count == _length)
+						_length = index;
+					else
+						insert_free_block(index, count);
+					return true;
+				}
+				GADT_WARNING_IF(is_debug(), true, "deallocate block failed.");
+				return false;
+			}
+
+			//construct element in the target space by placement new.
+			template<class... Types>
+			inline pointer construct(pointer target, Types&&... args)
+			{
+				return new (target) T(std::forward<Types>(args)...);
+			}
+
+			//destory element in the target space.
+			inline void destory(pointer target)
+			{
+				target->~T();
+			}
+
+			//return true if the memory of pointer belongs to this allocator.
+			inline bool is_owner(pointer target) const
+			{
+				return target >= _fir_element && target < _fir_element + _count;
+			}
+
+			//total size of alloc.
+			inline size_t total_size() const
+			{
+				return _count;
+			}
+
+			//remain size in the alloc, include the elements in deallocated blocks.
+			inline size_t remain_size() const
+			{
+				return _count - _length + _free_size;
+			}
+
+			//return size of the allocator.
+			inline size_t size() const
+			{
+				return _length - _free_size;
+			}
+
+			//return true if there is not available space in this allocator.
+			inline bool is_full() const
+			{
+				return remain_size() == 0;
+			}
+
+			//return true if this allocator is empty.
+			inline bool is_empty() const
+			{
+				return size() == 0;
+			}
+
+			//reset the allocator, all the elements in it should had been destoryed.
+			inline void flush()
+			{
+				_length = 0;
+				_free_size = 0;
+				_free_by_size.clear();
+				_free_by_index.clear();
+			}
+
+			//get info as string format
+			inline std::string info() const
+			{
+				std::stringstream ss;
+				ss << "{count : " << _count << ", remain: " << remain_size() << ", free blocks: " << _free_size << "}";
+				return ss.str();
+			}
+		};
+
+		/*
+		* AlignedAllocator is an allocator of standard containers, whose memory is aligned to the alignment given.
+		* std::allocator does not respect the alignment of over-aligned types before C++17, which is required by the
+		* elements aligned to cache line.
+		*
+		* [T] is the class type.
+		* [alignment] is the alignment of memory, which should be a power of 2. default is the alignment of T.
+		*/
+		template<typename T, size_t _alignment = alignof(T)>
+		class AlignedAllocator
+		{
+			static_assert(_alignment > 0 && (_alignment & (_alignment - 1)) == 0, "alignment should be a power of 2.");
+
+		public:
+			using value_type = T;
+
+			template<typename U>
+			struct rebind
+			{
+				using other = AlignedAllocator<U, _alignment>;
+			};
+
+		public:
+			AlignedAllocator() = default;
+
+			template<typename U>
+			AlignedAllocator(const AlignedAllocator<U, _alignment>&)
+			{
+			}
+
+			//allocate memory for count elements, the original pointer is stored in front of the aligned memory.
+			T* allocate(size_t count)
+			{
+				const size_t extra = _alignment + sizeof(void*);
+				void* raw = ::operator new(count * sizeof(T) + extra);
+				uintptr_t aligned = (reinterpret_cast<uintptr_t>(raw) + extra) & ~static_cast<uintptr_t>(_alignment - 1);
+				reinterpret_cast<void**>(aligned)[-1] = raw;
+				return reinterpret_cast<T*>(aligned);
+			}
+
+			//deallocate memory that is allocated by allocate.
+			void deallocate(T* p, size_t)
+			{
+				if (p != nullptr)
+					::operator delete(reinterpret_cast<void**>(p)[-1]);
+			}
+		};
+
+		template<typename T, typename U, size_t _alignment>
+		inline bool operator==(const AlignedAllocator<T, _alignment>&, const AlignedAllocator<U, _alignment>&)
+		{
+			return true;
+		}
+
+		template<typename T, typename U, size_t _alignment>
+		inline bool operator!=(const AlignedAllocator<T, _alignment>&, const AlignedAllocator<U, _alignment>&)
+		{
+			return false;
+		}
 	}	
 }
\ No newline at end of file
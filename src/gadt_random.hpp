@@ -0,0 +1,166 @@
+﻿/* Copyright (c) 2018 Junkai Lu <junkai-lu@outlook.com>.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "gadt_config.h"
+
+#pragma once
+
+namespace gadt
+{
+	namespace random
+	{
+		//golden ratio constant used to split seeds.
+		constexpr uint64_t GADT_RANDOM_GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+		//splitmix64 generator, which is used to expand a seed to the state of other generators.
+		inline uint64_t SplitMix64(uint64_t& state)
+		{
+			uint64_t z = (state += GADT_RANDOM_GOLDEN_GAMMA);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+			return z ^ (z >> 31);
+		}
+
+		//derive an independent seed from a base seed and a stream index, such as thread index.
+		inline uint64_t DeriveSeed(uint64_t seed, uint64_t stream)
+		{
+			uint64_t state = seed ^ (stream * GADT_RANDOM_GOLDEN_GAMMA);
+			SplitMix64(state);
+			return SplitMix64(state);
+		}
+
+		/*
+		* Xoshiro256 is the xoshiro256** pseudo random generator, which is fast and has good quality in all bits.
+		* it satisfies the requirements of UniformRandomBitGenerator, so it can be used by std::shuffle and the distributions of std.
+		*/
+		class Xoshiro256 final
+		{
+		public:
+			using result_type = uint64_t;
+
+		private:
+			uint64_t _s[4];
+
+			static inline uint64_t rotl(uint64_t x, int k)
+			{
+				return (x << k) | (x >> (64 - k));
+			}
+
+		public:
+			static constexpr result_type min() { return 0; }
+			static constexpr result_type max() { return UINT64_MAX; }
+
+			explicit Xoshiro256(uint64_t seed)
+			{
+				this->seed(seed);
+			}
+
+			//reset the state by seed.
+			inline void seed(uint64_t seed)
+			{
+				for (size_t i = 0; i < 4; i++)
+					_s[i] = SplitMix64(seed);
+			}
+
+			//get next random number.
+			inline result_type operator()()
+			{
+				const uint64_t result = rotl(_s[1] * 5, 7) * 9;
+				const uint64_t t = _s[1] << 17;
+				_s[2] ^= _s[0];
+				_s[3] ^= _s[1];
+				_s[1] ^= _s[2];
+				_s[0] ^= _s[3];
+				_s[2] ^= t;
+				_s[3] = rotl(_s[3], 45);
+				return result;
+			}
+		};
+
+		//create a seed that differs between calls and threads.
+		inline uint64_t EntropySeed()
+		{
+			static std::atomic<uint64_t> counter(0);
+			uint64_t seed = static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+			seed ^= static_cast<uint64_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+			return DeriveSeed(seed, counter.fetch_add(1, std::memory_order_relaxed));
+		}
+
+		//get the generator of current thread, which is seeded by entropy when it is used the first time.
+		inline Xoshiro256& ThreadEngine()
+		{
+			static thread_local Xoshiro256 engine(EntropySeed());
+			return engine;
+		}
+
+		//reset the generator of current thread by seed, which makes the following random numbers reproducible.
+		inline void SeedThread(uint64_t seed)
+		{
+			ThreadEngine().seed(seed);
+		}
+
+		//get a random 64-bit number from the generator of current thread.
+		inline uint64_t Next()
+		{
+			return ThreadEngine()();
+		}
+
+		//get an unbiased random number in [0, range) from a generator. range should be larger than 0.
+		template<typename Engine>
+		inline uint64_t Bounded(Engine& engine, uint64_t range)
+		{
+			if (range <= UINT32_MAX)
+			{
+				//multiply-shift with rejection, which avoids division in most cases.
+				const uint32_t bound = static_cast<uint32_t>(range);
+				uint64_t m = static_cast<uint64_t>(static_cast<uint32_t>(engine() >> 32)) * bound;
+				uint32_t low = static_cast<uint32_t>(m);
+				if (low < bound)
+				{
+					const uint32_t threshold = static_cast<uint32_t>(0 - bound) % bound;
+					while (low < threshold)
+					{
+						m = static_cast<uint64_t>(static_cast<uint32_t>(engine() >> 32)) * bound;
+						low = static_cast<uint32_t>(m);
+					}
+				}
+				return m >> 32;
+			}
+			const uint64_t threshold = (0 - range) % range;
+			uint64_t rnd = engine();
+			while (rnd < threshold)
+				rnd = engine();
+			return rnd % range;
+		}
+
+		//get an unbiased random number in [0, range) from the generator of current thread.
+		inline size_t Bounded(size_t range)
+		{
+			return static_cast<size_t>(Bounded(ThreadEngine(), static_cast<uint64_t>(range)));
+		}
+
+		//get a random real number in [0, 1) from the generator of current thread.
+		inline double Uniform()
+		{
+			return static_cast<double>(Next() >> 11) * (1.0 / 9007199254740992.0);
+		}
+	}
+}
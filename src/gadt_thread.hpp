@@ -0,0 +1,258 @@
+﻿/* Copyright (c) 2018 Junkai Lu <junkai-lu@outlook.com>.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include "gadtlib.h"
+
+#pragma once
+
+namespace gadt
+{
+	namespace thread
+	{
+		//pin the thread to the processor, which wraps around the number of processors. return false if it is failed.
+		inline bool PinThread(std::thread& target, size_t processor)
+		{
+			const size_t processors = os::SysNumberOfProcessors();
+			if (processors > 0)
+				processor %= processors;
+#ifdef __GADT_MSVC
+			DWORD_PTR mask = static_cast<DWORD_PTR>(1) << (processor % (sizeof(DWORD_PTR) * 8));
+			return SetThreadAffinityMask(target.native_handle(), mask) != 0;
+#else
+			cpu_set_t cpu_set;
+			CPU_ZERO(&cpu_set);
+			CPU_SET(processor % CPU_SETSIZE, &cpu_set);
+			return pthread_setaffinity_np(target.native_handle(), sizeof(cpu_set_t), &cpu_set) == 0;
+#endif
+		}
+
+		//allow the thread to run on all the processors, return false if it is failed.
+		inline bool UnpinThread(std::thread& target)
+		{
+#ifdef __GADT_MSVC
+			DWORD_PTR process_mask, system_mask;
+			if (GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask) == 0)
+				return false;
+			return SetThreadAffinityMask(target.native_handle(), process_mask) != 0;
+#else
+			cpu_set_t cpu_set;
+			CPU_ZERO(&cpu_set);
+			for (size_t i = 0; i < os::SysNumberOfProcessors() && i < CPU_SETSIZE; i++)
+				CPU_SET(i, &cpu_set);
+			return pthread_setaffinity_np(target.native_handle(), sizeof(cpu_set_t), &cpu_set) == 0;
+#endif
+		}
+
+		/*
+		* ThreadPool is a pool of persistent worker threads, which excute batches of indexed tasks.
+		*
+		* a batch is submitted by ParallelFor, the calling thread also excutes the tasks of its batch, so that 
+		* a task is allowed to submit batches to the same pool without deadlock.
+		* if affinity is enabled, worker i is pinned to processor i modulo the number of processors, and the workers never migrate between processors.
+		*/
+		class ThreadPool final
+		{
+		private:
+			using Task = std::function<void(size_t)>;
+
+			//a batch of tasks, task(i) is excuted once for each i in [0, count).
+			struct Batch
+			{
+				const Task&			task;
+				const size_t		count;
+				std::atomic<size_t>	next;	//index of next unclaimed task.
+				std::atomic<size_t>	done;	//count of finished tasks.
+
+				Batch(const Task& _task, size_t _count) :
+					task(_task),
+					count(_count),
+					next(0),
+					done(0)
+				{
+				}
+			};
+
+			using BatchPtr = std::shared_ptr<Batch>;
+
+			std::vector<std::thread>	_workers;
+			std::deque<BatchPtr>		_batches;		//batches that may have unclaimed tasks.
+			std::mutex					_mutex;
+			std::condition_variable		_task_cv;		//notify workers that new batch is submitted.
+			std::condition_variable		_done_cv;		//notify callers that a batch is finished.
+			bool						_stop;
+			bool						_affinity;		//pin workers to processors.
+
+		private:
+			//pin the worker to the processor of its index, a warning is raised if it is failed.
+			void pin_worker(size_t index)
+			{
+				if (!PinThread(_workers[index], index))
+				{
+					GADT_WARNING_IF(GADT_THREAD_ENABLE_WARNING, true, "TP001: failed to pin worker thread to processor.");
+				}
+			}
+
+			//remove the batch from the pending queue.
+			void remove_batch(const BatchPtr& batch)
+			{
+				auto iter = std::find(_batches.begin(), _batches.end(), batch);
+				if (iter != _batches.end())
+					_batches.erase(iter);
+			}
+
+			//claim and excute tasks of the batch until no task is left.
+			void excute_batch(Batch& batch)
+			{
+				for (size_t i = batch.next.fetch_add(1); i < batch.count; i = batch.next.fetch_add(1))
+				{
+					batch.task(i);
+					if (batch.done.fetch_add(1) + 1 == batch.count)
+					{
+						std::lock_guard<std::mutex> lock(_mutex);
+						_done_cv.notify_all();
+					}
+				}
+			}
+
+			//loop of worker threads.
+			void worker_loop()
+			{
+				for (;;)
+				{
+					BatchPtr batch;
+					{
+						std::unique_lock<std::mutex> lock(_mutex);
+						_task_cv.wait(lock, [this]()->bool { return _stop || !_batches.empty(); });
+						if (_stop)
+							return;
+						batch = _batches.front();
+						if (batch->next.load() >= batch->count)
+						{
+							remove_batch(batch);
+							continue;
+						}
+					}
+					excute_batch(*batch);
+				}
+			}
+
+		public:
+			//create pool with the number of worker threads.
+			explicit ThreadPool(size_t worker_count = 0) :
+				_stop(false),
+				_affinity(false)
+			{
+				reserve(worker_count);
+			}
+
+			ThreadPool(const ThreadPool&) = delete;
+			ThreadPool& operator=(const ThreadPool&) = delete;
+
+			~ThreadPool()
+			{
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					_stop = true;
+				}
+				_task_cv.notify_all();
+				for (auto& worker : _workers)
+					worker.join();
+			}
+
+			//make sure that there are at least worker_count workers in the pool.
+			void reserve(size_t worker_count)
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				while (_workers.size() < worker_count)
+				{
+					_workers.push_back(std::thread(&ThreadPool::worker_loop, this));
+					if (_affinity)
+						pin_worker(_workers.size() - 1);
+				}
+			}
+
+			//pin each worker to a processor, which keeps the cache and memory of workers local.
+			void enable_affinity()
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_affinity = true;
+				for (size_t i = 0; i < _workers.size(); i++)
+					pin_worker(i);
+			}
+
+			//allow workers to run on all the processors.
+			void disable_affinity()
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_affinity = false;
+				for (auto& worker : _workers)
+				{
+					if (!UnpinThread(worker))
+					{
+						GADT_WARNING_IF(GADT_THREAD_ENABLE_WARNING, true, "TP002: failed to unpin worker thread.");
+					}
+				}
+			}
+
+			//return true if the workers are pinned to processors.
+			bool affinity_enabled()
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				return _affinity;
+			}
+
+			//get the number of worker threads.
+			size_t worker_count()
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				return _workers.size();
+			}
+
+			//excute task(i) for each i in [0, count) by the workers and the calling thread, return after all tasks finished.
+			void ParallelFor(size_t count, const Task& task)
+			{
+				if (count == 0)
+					return;
+				BatchPtr batch = std::make_shared<Batch>(task, count);
+				if (count > 1)
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					_batches.push_back(batch);
+					if (count == 2)
+						_task_cv.notify_one();
+					else
+						_task_cv.notify_all();
+				}
+				excute_batch(*batch);
+				std::unique_lock<std::mutex> lock(_mutex);
+				_done_cv.wait(lock, [&batch]()->bool { return batch->done.load() == batch->count; });
+				remove_batch(batch);
+			}
+		};
+
+		//get the thread pool shared by all the search algorithms, whose workers are kept until the program exits.
+		inline ThreadPool& SharedPool()
+		{
+			static ThreadPool pool;
+			return pool;
+		}
+	}
+}
@@ -191,7 +191,7 @@ namespace gadt
 			std::string temp(length, '0');
 			for (size_t i = 0; i < length; i++)
 			{
-				size_t rnd = rand() % 62;
+				size_t rnd = random::Bounded(62);
 				if (rnd < 10)
 					temp[i] = static_cast<char>(48 + rnd);//0~9
 				else if (rnd < 36)
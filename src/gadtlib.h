@@ -20,6 +20,7 @@
 */
 
 #include "gadt_config.h"
+#include "gadt_random.hpp"
 
 //a marco use for parameters check.
 #ifdef GADT_WARNING
@@ -510,21 +511,21 @@ namespace gadt
 			//get random tint color
 			inline ConsoleColor GetRandomTint() const
 			{
-				size_t rnd = rand() % 6;
+				size_t rnd = random::Bounded(6);
 				return get_color(static_cast<size_t>(ConsoleColor::Blue) + rnd);
 			}
 
 			//get random deep color
 			inline ConsoleColor GetRandomDeep() const
 			{
-				size_t rnd = rand() % 6;
+				size_t rnd = random::Bounded(6);
 				return get_color(static_cast<size_t>(ConsoleColor::DeepBlue) + rnd);
 			}
 
 			//get random any color
 			inline ConsoleColor GetRandomAny() const
 			{
-				size_t rnd = rand() % 12;
+				size_t rnd = random::Bounded(12);
 				if (rnd >= 6)
 					rnd += 2;
 				return get_color(static_cast<size_t>(ConsoleColor::DeepBlue) + rnd);
@@ -758,7 +759,7 @@ namespace gadt
 		const T& GetRandomElement(const std::vector<T>& vec)
 		{
 			GADT_WARNING_IF(GADT_STL_ENABLE_WARNING, vec.size() == 0, "empty container");
-			size_t rnd = rand() % vec.size();
+			size_t rnd = random::Bounded(vec.size());
 			return vec[rnd];
 		}
 		
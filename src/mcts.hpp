@@ -22,6 +22,7 @@
 #include "gadtlib.h"
 #include "gadt_algorithm.hpp"
 #include "gadt_table.h"
+#include "gadt_thread.hpp"
 
 #pragma once
 
@@ -30,6 +31,41 @@ namespace gadt
 	//monte carlo tree search.
 	namespace mcts
 	{
+		/*
+		* MctsNodeStorage decides how the search tree is stored.
+		*
+		* Linked: every node keeps a copy of its state and its own action list.
+		* Compact: statistics, topology and actions are kept in contiguous pools (structure of arrays), 
+		*          states are recomputed along the selection path. it is only available for the searches 
+		*          that each thread owns its tree, and the tree policy is called with a view of node which only 
+		*          provides visit_count and win_count. linked storage is used instead if the tree policy can not 
+		*          accept the view. chance nodes are not supported by compact storage.
+		*/
+		enum class MctsNodeStorage : uint8_t
+		{
+			Linked = 0,
+			Compact = 1
+		};
+
+		/*
+		* MctsGcPolicy decides how the nodes are reclaimed when the allocator of a thread is nearly full.
+		*
+		* None: search stops when the allocator is full.
+		* PruneLeastVisited: the expanded nodes are ranked by visit count, and the subtrees under the least visited 
+		*                    nodes are released first.
+		* CollapseColdSubtrees: the nodes whose visit count is lower than a threshold are converted back to leaves, 
+		*                       the threshold is doubled until enough nodes are released.
+		*
+		* the statistics of collapsed nodes are kept, and they would be expanded again if selected. garbage 
+		* collection is only available for the searches that each thread owns its tree.
+		*/
+		enum class MctsGcPolicy : uint8_t
+		{
+			None = 0,
+			PruneLeastVisited = 1,
+			CollapseColdSubtrees = 2
+		};
+
 		/*
 		* MctsSetting is the setting of MCTS.
 		*
@@ -42,6 +78,17 @@ namespace gadt
 			size_t max_iteration_per_thread;	//set max iteration times.
 			size_t max_node_per_thread;			//pre-allocated memory for each thread.
 			size_t simulation_warning_length;
+			size_t simulation_cutoff_length;	//steps after which the simulation is truncated and evaluated by EvaluateRollout, 0 means the simulation is played to the end.
+			MctsNodeStorage node_storage;		//storage mode of the search tree.
+			uint32_t virtual_loss;				//visits added to the selected nodes until back propagation, which keeps threads away from the same path.
+			MctsGcPolicy gc_policy;				//garbage collection policy when allocator is nearly full.
+			double gc_high_water;				//garbage collection is excuted when the used ratio of allocator reaches it.
+			double gc_low_water;				//garbage collection releases nodes until the used ratio of allocator is lower than it.
+			uint64_t random_seed;				//seed of the random generator of each thread, 0 means the generators are seeded by entropy.
+			size_t leaf_simulations;			//simulations run in parallel for each expanded node, leaf parallelization is enabled if it is larger than 1. ignored by compact storage.
+			size_t sync_interval;				//iterations between the statistic synchronizations of the trees in root parallelization, 0 means never.
+			size_t sync_depth;					//levels of nodes below root node whose statistic is synchronized.
+			size_t transposition_table_size;	//entries of transposition table, which shares statistic between nodes with the same state hash. 0 means disabled.
 
 			//default setting constructor.
 			MctsSetting() :
@@ -49,7 +96,18 @@ namespace gadt
 				max_thread(1),
 				max_iteration_per_thread(10000),
 				max_node_per_thread(10000),
-				simulation_warning_length(1000)
+				simulation_warning_length(1000),
+				simulation_cutoff_length(0),
+				node_storage(MctsNodeStorage::Linked),
+				virtual_loss(0),
+				gc_policy(MctsGcPolicy::None),
+				gc_high_water(0.9),
+				gc_low_water(0.6),
+				random_seed(0),
+				leaf_simulations(1),
+				sync_interval(0),
+				sync_depth(1),
+				transposition_table_size(0)
 			{
 			}
 
@@ -66,26 +124,179 @@ namespace gadt
 				max_thread(_max_thread),
 				max_iteration_per_thread(_max_iteration_per_thread),
 				max_node_per_thread(_max_node_per_thread),
-				simulation_warning_length(_simulation_warning_length)
+				simulation_warning_length(_simulation_warning_length),
+				simulation_cutoff_length(0),
+				node_storage(MctsNodeStorage::Linked),
+				virtual_loss(0),
+				gc_policy(MctsGcPolicy::None),
+				gc_high_water(0.9),
+				gc_low_water(0.6),
+				random_seed(0),
+				leaf_simulations(1),
+				sync_interval(0),
+				sync_depth(1),
+				transposition_table_size(0)
 			{
 			}
 
 			//output print with str behind each line.
 			void PrintInfo() const override
 			{
-				console::Table tb(2, 6);
+				size_t index = 0;
+				console::Table tb(2, 17);
 				tb.set_width({ 12,6 });
 				tb.enable_title({"MCTS Setting", console::TableAlign::Middle });
-				tb.set_cell_in_row(0, { { "timeout" },					{ ToString(timeout) } });
-				tb.set_cell_in_row(1, { { "max_thread" },				{ ToString(max_thread) } });
-				tb.set_cell_in_row(2, { { "max_iteration_per_thread" },	{ ToString(max_iteration_per_thread) } });
-				tb.set_cell_in_row(3, { { "max_node_per_thread" },		{ ToString(max_node_per_thread) } });
-				tb.set_cell_in_row(4, { { "no_winner_index" },			{ ToString(no_winner_index) } });
-				tb.set_cell_in_row(5, { { "simulation_warning_length" },{ ToString(simulation_warning_length) } });
+				tb.set_cell_in_row(index++, { { "timeout" },					{ ToString(timeout) } });
+				tb.set_cell_in_row(index++, { { "max_thread" },				{ ToString(max_thread) } });
+				tb.set_cell_in_row(index++, { { "max_iteration_per_thread" },	{ ToString(max_iteration_per_thread) } });
+				tb.set_cell_in_row(index++, { { "max_node_per_thread" },		{ ToString(max_node_per_thread) } });
+				tb.set_cell_in_row(index++, { { "no_winner_index" },			{ ToString(no_winner_index) } });
+				tb.set_cell_in_row(index++, { { "simulation_warning_length" },{ ToString(simulation_warning_length) } });
+				tb.set_cell_in_row(index++, { { "simulation_cutoff_length" },	{ ToString(simulation_cutoff_length) } });
+				tb.set_cell_in_row(index++, { { "node_storage" },				{ node_storage == MctsNodeStorage::Compact ? "compact" : "linked" } });
+				tb.set_cell_in_row(index++, { { "virtual_loss" },				{ ToString(virtual_loss) } });
+				tb.set_cell_in_row(index++, { { "gc_policy" },				{ ToString(static_cast<int>(gc_policy)) } });
+				tb.set_cell_in_row(index++, { { "gc_high_water" },			{ ToString(gc_high_water) } });
+				tb.set_cell_in_row(index++, { { "gc_low_water" },				{ ToString(gc_low_water) } });
+				tb.set_cell_in_row(index++, { { "random_seed" },				{ ToString(random_seed) } });
+				tb.set_cell_in_row(index++, { { "leaf_simulations" },			{ ToString(leaf_simulations) } });
+				tb.set_cell_in_row(index++, { { "sync_interval" },			{ ToString(sync_interval) } });
+				tb.set_cell_in_row(index++, { { "sync_depth" },				{ ToString(sync_depth) } });
+				tb.set_cell_in_row(index++, { { "transposition_table_size" },	{ ToString(transposition_table_size) } });
 				tb.Print();
 			}
 		};
 
+		//reward accumulated by the simulations, a win is 1 and a loss is 0.
+		using MctsReward = double;
+
+		/*
+		* MctsTranspositionTable shares the statistic of the nodes that have the same state hash.
+		*
+		* each entry keeps the statistic of the most visited node of a state, the nodes adopt it in selection if it is more
+		* visited than themselves, so the search works as on a directed acyclic graph. the memory is bounded by the count of
+		* entries, an entry is replaced by another state if the new node is more visited. hash 0 is never stored.
+		*/
+		class MctsTranspositionTable final
+		{
+		public:
+			struct Entry
+			{
+				uint64_t key;
+				uint32_t visit_count;
+				MctsReward win_count;
+			};
+
+		private:
+			std::vector<Entry> _entries;
+
+			inline size_t index(uint64_t key) const
+			{
+				return static_cast<size_t>((key ^ (key >> 32)) % _entries.size());
+			}
+
+		public:
+			explicit MctsTranspositionTable(size_t size) :
+				_entries(size > 0 ? size : 1, Entry{ 0, 0, 0 })
+			{
+			}
+
+			//get the entry of the key, return nullptr if it does not exist.
+			inline const Entry* find(uint64_t key) const
+			{
+				const Entry& entry = _entries[index(key)];
+				if (key != 0 && entry.visit_count > 0 && entry.key == key)
+					return &entry;
+				return nullptr;
+			}
+
+			//store the statistic of a node if it is more visited than the entry.
+			inline void store(uint64_t key, uint32_t visit_count, MctsReward win_count)
+			{
+				Entry& entry = _entries[index(key)];
+				if (key != 0 && visit_count > entry.visit_count)
+					entry = Entry{ key, visit_count, win_count };
+			}
+
+			//remove all entries.
+			void clear()
+			{
+				std::fill(_entries.begin(), _entries.end(), Entry{ 0, 0, 0 });
+			}
+
+			//get the count of entries.
+			size_t size() const
+			{
+				return _entries.size();
+			}
+		};
+
+		//outcome of chance node, such as a result of dice.
+		template<typename Action>
+		struct MctsChance
+		{
+			Action action;		//action applied to state by UpdateState.
+			double probability;	//probability of the outcome.
+		};
+
+		//outcome of a simulation, which is the result of a finished game or the state where the simulation is truncated.
+		template<typename State, typename Result>
+		struct MctsRollout
+		{
+			Result result;		//result of the game, which is meaningless if the simulation is truncated.
+			State state;		//state where the simulation is stopped.
+			bool truncated;		//the simulation is truncated by simulation_cutoff_length, the reward is evaluated by EvaluateRollout.
+			std::vector<std::pair<AgentIndex, MctsReward>> rewards;	//evaluated rewards of truncated simulation for each acting agent.
+		};
+
+		//reward of the result for the player who acts in the state, which is given by ResultReward if the policy defines it.
+		template<typename Policy, typename State, typename Result>
+		inline auto RewardOfResult(const Policy& func, const State& state, const Result& result, int) -> decltype(static_cast<MctsReward>(func.ResultReward(state, result)))
+		{
+			return static_cast<MctsReward>(func.ResultReward(state, result));
+		}
+
+		//reward of the result for the player who acts in the state, which is 1 if AllowUpdateValue is true and 0 otherwise.
+		template<typename Policy, typename State, typename Result>
+		inline MctsReward RewardOfResult(const Policy& func, const State& state, const Result& result, long)
+		{
+			return func.AllowUpdateValue(state, result) ? 1 : 0;
+		}
+
+		//reward of the rollout for the player who acts in the state. the reward of truncated rollout is given by EvaluateRollout, 
+		//which is evaluated once for each agent given by ActingAgent and kept in the rollout, or for each state if the agent is unknown.
+		template<typename Policy, typename State, typename Result>
+		inline MctsReward RolloutReward(const Policy& func, const State& state, MctsRollout<State, Result>& rollout)
+		{
+			if (!rollout.truncated)
+				return RewardOfResult(func, state, rollout.result, 0);
+			const AgentIndex agent = func.ActingAgent(state);
+			if (agent == GADT_DEFAULT_NO_WINNER_INDEX)
+				return func.EvaluateRollout(state, rollout.state);
+			for (const auto& item : rollout.rewards)
+			{
+				if (item.first == agent)
+					return item.second;
+			}
+			const MctsReward reward = func.EvaluateRollout(state, rollout.state);
+			rollout.rewards.push_back({ agent, reward });
+			return reward;
+		}
+
+		//sample the index of an outcome by the probability of each outcome, the last one is returned if the sum of probabilities is less than 1.
+		template<typename ProbabilityFunc>
+		inline size_t SampleChance(size_t count, ProbabilityFunc probability)
+		{
+			double r = random::Uniform();
+			for (size_t i = 0; i + 1 < count; i++)
+			{
+				r -= probability(i);
+				if (r < 0)
+					return i;
+			}
+			return count - 1;
+		}
+
 		/*
 		* MctsFuncPackage include all necessary functions for MCTS.
 		*
@@ -97,6 +308,9 @@ namespace gadt
 		/*
 		* MctsNode is the node class in the monte carlo tree search.
 		*
+		* a node is a chance node if ChanceOutcomes gives any outcome for its state. the outcomes are stored as the actions
+		* of the node, all of them are expanded at once and the selection samples one of them by probability.
+		*
 		* [State] is the game-state class, which is defined by the user.
 		* [Action] is the game-action class, which is defined by the user.
 		* [Result] is the game-result class, which stand for a terminal state of the game.
@@ -109,20 +323,26 @@ namespace gadt
 			using Node			= MctsNode<State, Action, Result, _is_debug>;			//MctsNode
 			using pointer       = Node*;												//pointer of MctsNode
 			using reference     = Node&;												//reference of MctsNode
-			using Allocator		= gadt::stl::LinearAllocator<Node, _is_debug>;			//Allocate 
+			using Allocator		= gadt::stl::BlockAllocator<Node, _is_debug>;			//Allocate 
 			using FuncPackage	= MctsFuncPackage<State, Action, Result, _is_debug>;	//function package
 			using ActionList	= typename FuncPackage::ActionList;						//ActionList is the list of available actions.
+			using ChanceList	= typename FuncPackage::ChanceList;						//ChanceList is the list of outcomes of chance state.
+			using Rollout		= MctsRollout<State, Result>;							//outcome of simulation.
+			using NodePath		= std::vector<pointer>;									//selected nodes from root node.
 
 		private:
-			State			_state;				//state of this node.
-			AgentIndex		_winner_index;		//the winner index of the state.
-			uint32_t		_visit_count;		//how many times that this node had been visited.
-			uint32_t		_win_count;			//win time accmulated by the simulation.
-			ActionList		_action_list;		//action set of this node.
+			State					_state;				//state of this node.
+			AgentIndex				_winner_index;		//the winner index of the state.
+			uint64_t				_hash;				//hash of the state, which is 0 if transposition table is disabled.
+			std::atomic<uint32_t>	_visit_count;		//how many times that this node had been visited, include virtual loss.
+			std::atomic<MctsReward>	_win_count;			//reward accmulated by the simulation, which is the win time if the rewards are 0 or 1.
+			std::atomic<uint32_t>	_claimed_count;		//count of child slots that had been claimed by expansions.
+			std::atomic<uint32_t>	_child_count;		//count of expanded child nodes, which are ready to be visited.
+			ActionList				_action_list;		//action set of this node.
+			std::vector<double>		_probabilities;		//probabilities of the outcomes if it is a chance node, which is empty otherwise.
 			
-			pointer			_parent_node;		//pointer to parent node
-			pointer			_fir_child_node;	//pointer to left most child node.
-			pointer			_brother_node;		//pointer to breother node.
+			pointer					_parent_node;		//pointer to parent node
+			std::atomic<pointer>	_child_nodes;		//pointer to the child block, child node i is reached by action i.
 
 		public:
 
@@ -131,110 +351,333 @@ namespace gadt
 			const Action&		action(size_t i)		const { return _action_list[i]; }
 			size_t				action_count()			const { return _action_list.size(); }
 			AgentIndex			winner_index()			const { return _winner_index; }
-			uint32_t			visit_count()			const { return _visit_count; }
-			uint32_t			win_count()				const { return _win_count; }
-			double				avg_reward()			const { return static_cast<double>(win_count()) / static_cast<double>(visit_count()); }
+			bool				is_chance_node()		const { return !_probabilities.empty(); }
+			double				probability(size_t i)	const { return _probabilities[i]; }
+			uint64_t			hash()					const { return _hash; }
+			uint32_t			visit_count()			const { return _visit_count.load(std::memory_order_relaxed); }
+			MctsReward			win_count()				const { return _win_count.load(std::memory_order_relaxed); }
+			double				avg_reward()			const { return visit_count() > 0 ? static_cast<double>(win_count()) / static_cast<double>(visit_count()) : 0; }
 
 			pointer				parent_node()			const { return _parent_node; }
-			pointer				fir_child_node()		const { return _fir_child_node; }
-			pointer				brother_node()			const { return _brother_node; }
+			pointer				fir_child_node()		const { return child_count() > 0 ? child_block() : nullptr; }
+			pointer				child_node(size_t i)	const { return child_block() + i; }
+			size_t				child_count()			const { return _child_count.load(std::memory_order_acquire); }
 
 			bool				exist_parent_node()		const { return _parent_node != nullptr; }
-			bool				exist_child_node()		const { return _fir_child_node != nullptr; }
-			bool				exist_brother_node()	const { return _brother_node != nullptr; }
+			bool				exist_child_node()		const { return child_count() > 0; }
 			bool				is_root()				const { return _parent_node == nullptr; }
 			
 		private:
 
-			//exist unactived action in the action set.
-			inline bool exist_unactivated_action() const
+			//get the child block.
+			inline pointer child_block() const
 			{
-				size_t action_size = _action_list.size();
-				volatile size_t child_size = child_count();
-				if (action_size == 0)
-					return false;
-				else if (action_size == child_size)
-					return false;
-				return true;
+				return _child_nodes.load(std::memory_order_acquire);
 			}
 
-			//get next action.
-			inline const Action& next_action()
+			//exist unactived action in the action set, which is not claimed by any expansion.
+			inline bool exist_unactivated_action() const
 			{
-				return _action_list[child_count()];
+				return _claimed_count.load(std::memory_order_relaxed) < _action_list.size();
 			}
 
 			//increase visited time.
-			inline void incr_visit_count()
+			inline void incr_visit_count(uint32_t count)
+			{
+				_visit_count.fetch_add(count, std::memory_order_relaxed);
+			}
+
+			//remove the virtual loss that is added during selection.
+			inline void remove_virtual_loss(uint32_t virtual_loss)
+			{
+				if (virtual_loss > 0)
+					_visit_count.fetch_sub(virtual_loss, std::memory_order_relaxed);
+			}
+
+			//increase win reward, atomic floating point has no fetch_add before C++20.
+			inline void incr_win_count(MctsReward reward = 1)
+			{
+				MctsReward expected = _win_count.load(std::memory_order_relaxed);
+				while (!_win_count.compare_exchange_weak(expected, expected + reward, std::memory_order_relaxed))
+				{
+				}
+			}
+
+			//get the child block, allocate it and install it by CAS if not exist.
+			//return nullptr if the allocator is run out of memory.
+			pointer acquire_child_block(Allocator& allocator)
+			{
+				pointer block = child_block();
+				if (block != nullptr)
+					return block;
+				pointer new_block = allocator.allocate(_action_list.size());
+				if (new_block == nullptr)
+					return nullptr;
+				if (_child_nodes.compare_exchange_strong(block, new_block, std::memory_order_acq_rel))
+					return new_block;
+
+				//other thread had installed the block.
+				allocator.deallocate(new_block, _action_list.size());
+				return block;
+			}
+
+			//destory all the nodes in the subtree except this node from the bottom up, without recursion.
+			//the blocks that belong to the allocator would be deallocated, nothing is deallocated if allocator is nullptr.
+			void release_subtree(Allocator* allocator)
 			{
-				_visit_count++;
+				if (child_count() == 0 && (allocator == nullptr || child_block() == nullptr))
+					return;
+				NodePath nodes(1, this);
+				for (size_t i = 0; i < nodes.size(); i++)
+				{
+					for (size_t n = 0; n < nodes[i]->child_count(); n++)
+						nodes.push_back(nodes[i]->child_node(n));
+				}
+				for (size_t i = nodes.size(); i-- > 0;)
+				{
+					pointer node = nodes[i];
+					pointer block = node->child_block();
+					size_t count = node->child_count();
+					for (size_t n = 0; n < count; n++)
+					{
+						block[n].~MctsNode();//child nodes of block[n] had been released.
+					}
+					node->_child_count = 0;
+					node->_claimed_count = 0;
+					if (allocator != nullptr && block != nullptr && allocator->is_owner(block))
+					{
+						bool b = allocator->deallocate(block, node->_action_list.size());
+						GADT_WARNING_IF(is_debug(), b == false, "MCTS105: free child node failed.");
+					}
+					if (allocator != nullptr)
+						node->_child_nodes = nullptr;
+				}
+			}
+
+			//select the child node with highest tree policy value.
+			//return nullptr if there is no action or no action is claimed.
+			template<typename Policy>
+			pointer select_child(const Policy& func) const
+			{
+				if (_action_list.empty())
+					return nullptr;
+
+				//the actions had been claimed, wait for the first child node is published by other thread.
+				size_t count = child_count();
+				while (count == 0)
+				{
+					if (_claimed_count.load(std::memory_order_relaxed) == 0)
+						return nullptr;
+					std::this_thread::yield();
+					count = child_count();
+				}
+
+				pointer block = child_block();
+				pointer max_ucb_child_node = block;
+				UcbValue max_ucb_value = 0;
+				for (size_t i = 0; i < count; i++)
+				{
+					UcbValue child_node_ucb_value = func.TreePolicyValue(*this, block[i]);
+					if (child_node_ucb_value > max_ucb_value)
+					{
+						max_ucb_child_node = block + i;
+						max_ucb_value = child_node_ucb_value;
+					}
+				}
+				return max_ucb_child_node;
 			}
 
-			//increase win time.
-			inline void incr_win_count()
+			//sample a child node of chance node by the probabilities of outcomes.
+			pointer sample_child() const
 			{
-				_win_count++;
+				//all the outcomes had been claimed, wait for them to be published by other threads.
+				while (child_count() < _action_list.size())
+				{
+					std::this_thread::yield();
+				}
+				return child_block() + SampleChance(_probabilities.size(), [this](size_t i)->double { return _probabilities[i]; });
 			}
 
-			//free the node from allocator.
-			void FreeFromAllocator(Allocator& allocator)
+			//construct the child node that is reached by next unclaimed action.
+			//the new node is visited by this iteration if visited is true, otherwise its visit count is 0 until it is selected.
+			//the slot of new child is claimed atomically and child nodes are published in the order of their index.
+			//return nullptr if there is no unactivated action or the allocator is run out of memory.
+			template<typename Policy>
+			pointer claim_child(Allocator& allocator, const Policy& func, const MctsSetting& setting, bool visited)
 			{
-				//free all child node if possible.
-				if (brother_node() != nullptr)
+				if (!exist_unactivated_action())
+					return nullptr;
+				pointer block = acquire_child_block(allocator);
+				if (block == nullptr)
+					return nullptr;
+				uint32_t index = _claimed_count.fetch_add(1, std::memory_order_relaxed);
+				if (index >= _action_list.size())
+				{
+					_claimed_count.fetch_sub(1, std::memory_order_relaxed);
+					return nullptr;
+				}
+				State new_state = _state;
+				func.UpdateState(new_state, _action_list[index]);
+				pointer new_node = allocator.construct(block + index, new_state, this, func, setting);
+
+				//the new node is visited by this iteration until back propagation, or it waits to be sampled.
+				if (visited)
+					new_node->incr_visit_count(setting.virtual_loss);
+				else
+					new_node->set_visit_count(0);
+
+				//wait for the nodes with lower index are published.
+				uint32_t expected = index;
+				while (!_child_count.compare_exchange_weak(expected, index + 1, std::memory_order_release, std::memory_order_relaxed))
 				{
-					brother_node()->FreeFromAllocator(allocator);
+					expected = index;
+					std::this_thread::yield();
 				}
+				return new_node;
+			}
 
-				if (fir_child_node() != nullptr)
+			//adopt the statistic of transposition table for the child nodes that are less visited than the entries.
+			//the adopted visits never exceed the visits of this node, and the average reward of the entry is kept.
+			void adopt_transpositions(const MctsTranspositionTable& table)
+			{
+				const uint32_t limit = visit_count();
+				pointer block = child_block();
+				for (size_t i = 0; i < child_count(); i++)
 				{
-					fir_child_node()->FreeFromAllocator(allocator);
+					const MctsTranspositionTable::Entry* entry = table.find(block[i]._hash);
+					if (entry != nullptr && entry->visit_count > block[i].visit_count() && block[i].visit_count() < limit)
+					{
+						const uint32_t visit = std::min(entry->visit_count, limit);
+						block[i]._visit_count.store(visit, std::memory_order_relaxed);
+						block[i]._win_count.store(entry->win_count * visit / entry->visit_count, std::memory_order_relaxed);
+					}
 				}
+			}
 
-				//free the node itself.
-				bool b = allocator.destory(this);
-				GADT_WARNING_IF(is_debug(), b == false, "MCTS105: free child node failed.");
+			//store the statistic of the selected nodes except root node into transposition table.
+			static void StoreTranspositions(const NodePath& path, MctsTranspositionTable* table)
+			{
+				if (table == nullptr)
+					return;
+				for (size_t i = 1; i < path.size(); i++)
+					table->store(path[i]->_hash, path[i]->visit_count(), path[i]->win_count());
 			}
 
 		public:
 
-			MctsNode(const State& state, pointer parent_node, const FuncPackage& func, const MctsSetting& setting) :
+			template<typename Policy>
+			MctsNode(const State& state, pointer parent_node, const Policy& func, const MctsSetting& setting) :
 				_state(state),
 				_winner_index(func.DetermineWinner(state)),
+				_hash(setting.transposition_table_size > 0 ? func.StateHash(state) : 0),
 				_visit_count(1),
 				_win_count(0),
+				_claimed_count(0),
+				_child_count(0),
 				_parent_node(parent_node),
-				_fir_child_node(nullptr),
-				_brother_node(nullptr)
+				_child_nodes(nullptr)
 			{
 				if (!is_end_state(setting))
 				{
-					func.MakeAction(_state, _action_list);
+					ChanceList chances;
+					func.ChanceOutcomes(_state, chances);
+					if (chances.empty())
+					{
+						func.MakeAction(_state, _action_list);
+						return;
+					}
+
+					//the outcomes of chance state are stored as actions.
+					double total_probability = 0;
+					_action_list.reserve(chances.size());
+					_probabilities.reserve(chances.size());
+					for (const auto& chance : chances)
+					{
+						_action_list.push_back(chance.action);
+						_probabilities.push_back(chance.probability);
+						total_probability += chance.probability;
+					}
+					GADT_WARNING_IF(is_debug(), (total_probability < 0.999999 || total_probability > 1.000001), "MCTS111: total probability of chance outcomes is not 1.");
 				}
 			}
 
 			MctsNode(const MctsNode&) = delete;
 
+			//the lifetime of child nodes is owned by their parent, but the memory is owned by allocators.
+			~MctsNode()
+			{
+				release_subtree(nullptr);
+			}
+
 			//4.the simulation result is back propagated through the selected nodes to update their statistics.
-			void BackPropagation(const Result& result, const FuncPackage& func)
+			//path[0] is the root node and path[i] is a child node of path[i - 1].
+			template<typename Policy>
+			static void BackPropagation(const NodePath& path, Rollout& rollout, const Policy& func, const MctsSetting& setting)
 			{
-				if (exist_parent_node())
+				for (size_t i = path.size(); i-- > 0;)
 				{
-					//update node if allow.
-					if (func.AllowUpdateValue(parent_node()->state(), result))
+					path[i]->remove_virtual_loss(setting.virtual_loss);
+
+					//update node by the reward.
+					if (i > 0)
 					{
-						incr_win_count();
+						MctsReward reward = RolloutReward(func, path[i - 1]->state(), rollout);
+						if (reward != 0)
+							path[i]->incr_win_count(reward);
 					}
+				}
+			}
 
-					//update parent node.
-					parent_node()->BackPropagation(result, func);
+			//back propagate the results of the simulations from the same leaf in one pass.
+			template<typename Policy>
+			static void BackPropagation(const NodePath& path, std::vector<Rollout>& rollouts, const Policy& func, const MctsSetting& setting)
+			{
+				const uint32_t extra_visit = static_cast<uint32_t>(rollouts.size()) - 1;
+				for (size_t i = path.size(); i-- > 0;)
+				{
+					path[i]->remove_virtual_loss(setting.virtual_loss);
+					path[i]->incr_visit_count(extra_visit);
+
+					//update node by the sum of rewards.
+					if (i > 0)
+					{
+						MctsReward reward = 0;
+						for (Rollout& rollout : rollouts)
+							reward += RolloutReward(func, path[i - 1]->state(), rollout);
+						if (reward != 0)
+							path[i]->incr_win_count(reward);
+					}
 				}
 			}
 
+			//run simulations from this node by the workers of pool and the calling thread, the count of the results is leaf_simulations.
+			//if random_seed is set, each simulation is seeded by its index from the generator of calling thread, so that 
+			//the results do not depend on which worker runs it, then the calling thread is seeded by the next index.
+			template<typename Policy>
+			void LeafSimulation(thread::ThreadPool& pool, const Policy& func, const MctsSetting& setting, std::vector<Rollout>& rollouts)
+			{
+				const bool seeded = setting.random_seed != 0;
+				const uint64_t seed = seeded ? random::Next() : 0;
+				rollouts.assign(setting.leaf_simulations, Rollout{ Result(), _state, false, {} });
+				pool.ParallelFor(rollouts.size(), [&](size_t i)->void {
+					if (seeded)
+						random::SeedThread(random::DeriveSeed(seed, i));
+					rollouts[i] = Simulation(func, setting);
+				});
+				if (seeded)
+					random::SeedThread(random::DeriveSeed(seed, rollouts.size()));
+			}
+
 			//3.simulation is run from the new node according to the default policy to produce a result.
-			Result Simulation(const FuncPackage& func, const MctsSetting& setting)
+			//the simulation is truncated after simulation_cutoff_length decision moves if it is not 0, chance outcomes are not counted.
+			template<typename Policy>
+			Rollout Simulation(const Policy& func, const MctsSetting& setting)
 			{
-				State state = _state;	//copy
+				Rollout rollout{ Result(), _state, false, {} };	//copy
+				State& state = rollout.state;
 				ActionList actions;
+				ChanceList chances;
+				size_t ply = 0;
 				for (size_t i = 0;; i++)
 				{
 					GADT_WARNING_IF(is_debug(), i > setting.simulation_warning_length, "MCTS103: out of default policy process max length.");
@@ -245,7 +688,24 @@ namespace gadt
 					//return result if exist.
 					if (winner != setting.no_winner_index)
 					{
-						return func.StateToResult(state, winner);
+						rollout.result = func.StateToResult(state, winner);
+						return rollout;
+					}
+
+					//stop the simulation and leave the state to be evaluated.
+					if (setting.simulation_cutoff_length > 0 && ply >= setting.simulation_cutoff_length)
+					{
+						rollout.truncated = true;
+						return rollout;
+					}
+
+					//sample an outcome if it is a chance state.
+					chances.clear();
+					func.ChanceOutcomes(state, chances);
+					if (!chances.empty())
+					{
+						func.UpdateState(state, chances[SampleChance(chances.size(), [&](size_t i)->double { return chances[i].probability; })].action);
+						continue;
 					}
 
 					//generate new actions.
@@ -258,139 +718,187 @@ namespace gadt
 
 					//state update.
 					func.UpdateState(state, action);
+					ply++;
 				}
-				return func.StateToResult(_state, setting.no_winner_index);
+				return rollout;
 			}
 
-			//2.one child node would be added to expand the tree, acccording to the available actions.
-			void Expandsion(Allocator& allocator ,const FuncPackage& func, const MctsSetting& setting)
+			//2.one child node would be added to expand the tree, which is reached by next unactivated action.
+			//the child block is allocated at the first time.
+			//the slot of new child is claimed atomically and child nodes are published in the order of their index.
+			//return nullptr if there is no unactivated action or the allocator is run out of memory.
+			template<typename Policy>
+			pointer ExpandChild(Allocator& allocator, const Policy& func, const MctsSetting& setting)
 			{
-				if (is_end_state(setting))
-				{
-					Result result = func.StateToResult(_state, _winner_index);//return the result of this node.
-					BackPropagation(result, func);
-					return; //back propagate from this node to root.
-				}
-				else
-				{
-					volatile const size_t new_child_index = child_count();
-					if (new_child_index < _action_list.size())
-					{
-						//create new node.
-						State new_state = _state;
-						func.UpdateState(new_state, _action_list[new_child_index]);
-						pointer new_node = allocator.construct(new_state, this, func, setting);
-						Result result = new_node->Simulation(func, setting);
-						new_node->_parent_node = this;
-
-						//link to father. return if link failed.
-						if (!link_as_child(new_child_index, new_node)) { return; }
-						new_node->BackPropagation(result, func);
-					}
-					return; //fialed to find the next expandable child node, return;
-				}
+				return claim_child(allocator, func, setting, true);
 			}
 
-			//1. select the most urgent expandable node,and get the result to update statistic.
-			void Selection(Allocator& allocator,const FuncPackage& func, const MctsSetting& setting)
+			//expand the child node reached by the unexpanded action of the index, which is moved to the next child slot so that
+			//the actions before it stay unexpanded. it should not be called while other threads are expanding this node.
+			//return nullptr if the action had been expanded or the allocator is run out of memory.
+			template<typename Policy>
+			pointer ExpandAction(size_t action_index, Allocator& allocator, const Policy& func, const MctsSetting& setting)
 			{
-				incr_visit_count();
+				const size_t slot = child_count();
+				if (action_index < slot || action_index >= _action_list.size())
+					return nullptr;
+				std::swap(_action_list[slot], _action_list[action_index]);
+				if (is_chance_node())
+					std::swap(_probabilities[slot], _probabilities[action_index]);
+				return claim_child(allocator, func, setting, true);
+			}
 
-				if (is_end_state(setting))
+			//all the outcomes of chance node are expanded at once, they are not visited until they are sampled.
+			//return false if the allocator is run out of memory before all the outcomes are claimed.
+			template<typename Policy>
+			bool ExpandChance(Allocator& allocator, const Policy& func, const MctsSetting& setting)
+			{
+				while (exist_unactivated_action())
 				{
-					Result result = func.StateToResult(_state, _winner_index);
-					BackPropagation(result, func);
+					if (claim_child(allocator, func, setting, false) == nullptr)
+						return !exist_unactivated_action();
 				}
-				else
+				return true;
+			}
+
+			//1. select the most urgent expandable node iteratively, and get the result to update statistic.
+			//virtual loss is added to the selected nodes, which would be removed in back propagation.
+			//path is a reusable buffer to record the selected nodes.
+			//if leaf pool is given and leaf_simulations is larger than 1, the new node is simulated by the pool in parallel.
+			//if transposition table is given, the statistic is shared by the nodes with the same state hash.
+			//return false if the iteration is stopped because the allocator is run out of memory.
+			template<typename Policy>
+			bool Selection(Allocator& allocator, const Policy& func, const MctsSetting& setting, NodePath& path, thread::ThreadPool* leaf_pool = nullptr, MctsTranspositionTable* table = nullptr)
+			{
+				const bool leaf_parallel = leaf_pool != nullptr && setting.leaf_simulations > 1;
+				path.clear();
+				pointer node = this;
+				for (;;)
 				{
-					if (exist_unactivated_action())
+					path.push_back(node);
+					node->incr_visit_count(1 + setting.virtual_loss);
+
+					//return the result of terminal state, the state without any action is regarded as terminal as well.
+					if (node->is_end_state(setting) || node->_action_list.empty())
 					{
-						Expandsion(allocator, func, setting);
+						Rollout rollout{ func.StateToResult(node->_state, node->_winner_index), node->_state, false, {} };
+						if (leaf_parallel)
+						{
+							std::vector<Rollout> rollouts(setting.leaf_simulations, rollout);
+							BackPropagation(path, rollouts, func, setting);
+						}
+						else
+							BackPropagation(path, rollout, func, setting);
+						StoreTranspositions(path, table);
+						return true;
 					}
-					else
-					{
-						GADT_WARNING_IF(is_debug(), _action_list.size() == 0, "MCTS106: empty action set during tree policy.");
 
-						pointer max_ucb_child_node = fir_child_node();
-						UcbValue max_ucb_value = 0;
+					//expand all the outcomes of chance node and sample one of them.
+					if (node->is_chance_node())
+					{
+						if (!node->ExpandChance(allocator, func, setting))
+						{
+							for (pointer p : path) { p->remove_virtual_loss(setting.virtual_loss); }
+							return false;
+						}
+						node = node->sample_child();
+						continue;
+					}
 
-						pointer node = fir_child_node();
-						while(node != nullptr)
+					//expand the node and simulate from the new node.
+					if (node->exist_unactivated_action())
+					{
+						pointer new_node = node->ExpandChild(allocator, func, setting);
+						if (new_node != nullptr)
 						{
-							UcbValue child_node_ucb_value = func.TreePolicyValue(*this, *node);
-							if (child_node_ucb_value > max_ucb_value)
+							path.push_back(new_node);
+							if (leaf_parallel)
 							{
-								max_ucb_child_node = node;
-								max_ucb_value = child_node_ucb_value;
+								std::vector<Rollout> rollouts;
+								new_node->LeafSimulation(*leaf_pool, func, setting, rollouts);
+								BackPropagation(path, rollouts, func, setting);
 							}
-							node = node->brother_node();
+							else
+							{
+								Rollout rollout = new_node->Simulation(func, setting);
+								BackPropagation(path, rollout, func, setting);
+							}
+							StoreTranspositions(path, table);
+							return true;
+						}
+
+						//run out of memory.
+						if (node->exist_unactivated_action())
+						{
+							for (pointer p : path) { p->remove_virtual_loss(setting.virtual_loss); }
+							return false;
 						}
-						GADT_WARNING_IF(is_debug(), max_ucb_child_node == nullptr, "MCTS108: best child node pointer is nullptr.");
-						max_ucb_child_node->Selection(allocator, func, setting);
 					}
+
+					if (table != nullptr)
+						node->adopt_transpositions(*table);
+					pointer child = node->select_child(func);
+
+					//no child is claimed, which only happens if the expansion failed for lack of memory.
+					if (child == nullptr)
+					{
+						for (pointer p : path) { p->remove_virtual_loss(setting.virtual_loss); }
+						return false;
+					}
+					node = child;
 				}
+				return true;
 			}
 
-			//return true if the state is the terminal-state of the game.
-			inline bool is_end_state(const MctsSetting& setting) const
+			//select and update statistic with a temporary path buffer.
+			template<typename Policy>
+			bool Selection(Allocator& allocator, const Policy& func, const MctsSetting& setting)
 			{
-				return _winner_index != setting.no_winner_index;
+				NodePath path;
+				return Selection(allocator, func, setting, path);
 			}
 
-			//get child num
-			size_t child_count() const
+			//free all the child nodes, the blocks that belong to the allocator would be deallocated.
+			void FreeChildNodes(Allocator& allocator)
 			{
-				size_t num = 0;
-				if (exist_child_node())
-				{
-					Node* node = fir_child_node();
-					num++;
-					while (node->exist_brother_node())
-					{
-						node = node->brother_node();
-						num++;
-					}
-				}
-				return num;
+				release_subtree(&allocator);
+				_child_nodes = nullptr;
 			}
 
-			//get child node by index.
-			bool link_as_child(size_t index, pointer node)
+			//detach the child node from this node and free other child nodes, the detached node becomes a root node.
+			//the child block is not owned by this node any more, which should be deallocated by the caller.
+			pointer DetachChild(size_t index, Allocator& allocator)
 			{
-				if (index == 0)
-				{
-					_fir_child_node = node;
-				}
-				else
+				pointer block = child_block();
+				size_t count = child_count();
+				for (size_t i = 0; i < count; i++)
 				{
-					pointer* p = &_fir_child_node;
-					for (size_t i = 0; i < index; i++)
+					if (i != index)
 					{
-						if ((*p) == nullptr)
-						{
-							return false;
-						}
-						p = &((*p)->_brother_node);
+						block[i].FreeChildNodes(allocator);
+						block[i].~MctsNode();
 					}
-					*p = node;
 				}
-				return true;
+				block[index]._parent_node = nullptr;
+				_child_count = 0;
+				_claimed_count = 0;
+				_child_nodes = nullptr;
+				return block + index;
+			}
+
+			//return true if the state is the terminal-state of the game.
+			inline bool is_end_state(const MctsSetting& setting) const
+			{
+				return _winner_index != setting.no_winner_index;
 			}
 
 			//get info of this node.
 			std::string info() const
 			{
 				std::stringstream ss;
-				double avg = static_cast<double>(win_count()) / static_cast<double>(visit_count());
+				double avg = avg_reward();
 				ss << "{ visited:" << visit_count() << " win:" << win_count() <<" avg:" << avg << " child";
-				if (exist_unactivated_action())
-				{
-					ss << child_count() << "/" << action_list().size();
-				}
-				else
-				{
-					ss << action_list().size() << "/" << action_list().size();
-				}
+				ss << child_count() << "/" << action_list().size();
 				ss << " }";
 				return ss.str();
 			}
@@ -399,11 +907,9 @@ namespace gadt
 			size_t subtree_size() const
 			{
 				size_t count = 1;
-				pointer child = fir_child_node();
-				while (child != nullptr)
+				for (size_t i = 0; i < child_count(); i++)
 				{
-					count += child->subtree_size();
-					child = child->brother_node();
+					count += child_node(i)->subtree_size();
 				}
 				return count;
 			}
@@ -412,153 +918,571 @@ namespace gadt
 			double exception() const
 			{
 				size_t visit_count = 0;
-				size_t win_count = 0;
-				for (pointer child = fir_child_node(); child != nullptr; child = child->brother_node())
+				MctsReward win_count = 0;
+				for (size_t i = 0; i < child_count(); i++)
 				{
-					visit_count += child->visit_count();
-					win_count += child->win_count();
+					visit_count += child_node(i)->visit_count();
+					win_count += child_node(i)->win_count();
 				}
-				return static_cast<double>(win_count) / static_cast<double>(visit_count);
+				return visit_count > 0 ? static_cast<double>(win_count) / static_cast<double>(visit_count) : 0;
 			}
 
 			//get list of all childs
 			std::vector<Node*> child_ptr_set() const
 			{
-				std::vector<Node*> child_list;
-				pointer child = fir_child_node();
+				std::vector<Node*> child_list(child_count());
+				for (size_t i = 0; i < child_list.size(); i++)
+				{
+					child_list[i] = child_node(i);
+				}
+				return child_list;
+			}
+
+			//set visted count of this node.
+			void set_visit_count(uint32_t value)
+			{
+				_visit_count.store(value, std::memory_order_relaxed);
+			}
+
+			//set win reward of this node.
+			void set_win_count(MctsReward value)
+			{
+				_win_count.store(value, std::memory_order_relaxed);
+			}
+
+			//return the value of _is_debug.
+			constexpr inline bool is_debug() const
+			{
+				return _is_debug;
+			}
+		};
+
+		/*
+		* MctsPolicyBase provides the default functions of a static policy for MCTS.
+		*
+		* a static policy is a type whose functions are static, so that they can be inlined into the search. derive
+		* from MctsPolicyBase and define UpdateState, MakeAction, DetermineWinner, StateToResult and AllowUpdateValue
+		* with the same signatures as MctsFuncPackage. the default functions can be hidden by the derived policy.
+		* ResultReward(state, result) can be defined to give fractional rewards instead of AllowUpdateValue, such as the
+		* rewards of each player that are kept in the result of a multi-player game. ActingAgent(state) can be defined
+		* so that a truncated simulation is evaluated by EvaluateRollout once for each agent rather than once for each level.
+		*
+		* [StateType] is the game-state class, which is defined by the user.
+		* [ActionType] is the game-action class, which is defined by the user.
+		* [ResultType] is the game-result class, which stand for a terminal state of the game.
+		* [is_debug] means some debug info would not be ignored if it is true. this may result in a little degradation of performance.
+		*/
+		template<typename StateType, typename ActionType, typename ResultType = AgentIndex, bool _is_debug = false>
+		struct MctsPolicyBase
+		{
+		public:
+			using State			= StateType;
+			using Action		= ActionType;
+			using Result		= ResultType;
+			using ActionList	= typename GameAlgorithmFuncPackageBase<State, Action, _is_debug>::ActionList;
+			using ChanceList	= std::vector<MctsChance<Action>>;
+
+		public:
+			//value of child node in selection process, which is UCB1 by default.
+			template<typename Node>
+			static UcbValue TreePolicyValue(const Node& parent, const Node& child)
+			{
+				UcbValue avg = static_cast<UcbValue>(child.win_count()) / static_cast<UcbValue>(child.visit_count());
+				return policy::UCB1(avg, static_cast<UcbValue>(parent.visit_count()), static_cast<UcbValue>(child.visit_count()));
+			}
+
+			//the default policy to select action, which is random by default.
+			static const Action& DefaultPolicy(const ActionList& actions)
+			{
+				GADT_WARNING_IF(_is_debug, actions.size() == 0, "MCTS104: empty action set during default policy.");
+				return actions[random::Bounded(actions.size())];
+			}
+
+			//allow node to extend child node.
+			template<typename Node>
+			static bool AllowExtend(const Node&)
+			{
+				return true;
+			}
+
+			//hash of state, which should be defined if transposition table is enabled. 0 means the state has no hash.
+			static uint64_t StateHash(const State&)
+			{
+				return 0;
+			}
+
+			//get the outcomes of chance state, such as the results of dice. no outcome means the state is not a chance state.
+			static void ChanceOutcomes(const State&, ChanceList&)
+			{
+			}
+
+			//reward in [0, 1] of the player who acts in the state if the simulation is truncated at rollout_state.
+			//it should be defined if simulation_cutoff_length is set, the truncated simulation is regarded as a draw by default.
+			static double EvaluateRollout(const State&, const State&)
+			{
+				return 0.5;
+			}
+
+			//the agent who acts in the state, whose reward of truncated simulation is evaluated once and shared by the levels
+			//of the same agent. GADT_DEFAULT_NO_WINNER_INDEX means unknown, then the reward is evaluated for each level.
+			static AgentIndex ActingAgent(const State&)
+			{
+				return GADT_DEFAULT_NO_WINNER_INDEX;
+			}
+
+			//select best action of root node after iterations finished, which is the most visited one by default.
+			template<typename Node>
+			static size_t RootSelection(const Node& root)
+			{
+				size_t best_visit = root.child_node(0)->visit_count();
+				size_t best_index = 0;
+				for (size_t i = 0; i < root.child_count(); i++)
+				{
+					if (root.child_node(i)->visit_count() > best_visit)
+					{
+						best_visit = root.child_node(i)->visit_count();
+						best_index = i;
+					}
+				}
+				return best_index;
+			}
+		};
+
+		/*
+		* MctsFuncPackage include all necessary functions for MCTS.
+		* it is the policy adapter of std::function, which can be set at runtime.
+		*
+		* use MctsFuncPackage(...) to construct a new function package.
+		*/
+		template<typename State, typename Action, typename Result, bool _is_debug>
+		struct MctsFuncPackage final : public GameAlgorithmFuncPackageBase<State, Action, _is_debug>
+		{
+		public:
+#ifdef __GADT_GNUC
+			using ActionList = typename GameAlgorithmFuncPackageBase<State, Action, _is_debug>::ActionList;
+			using UpdateStateFunc = typename GameAlgorithmFuncPackageBase<State, Action, _is_debug>::UpdateStateFunc;
+			using MakeActionFunc = typename GameAlgorithmFuncPackageBase<State, Action, _is_debug>::MakeActionFunc;
+			using DetermineWinnerFunc = typename GameAlgorithmFuncPackageBase<State, Action, _is_debug>::DetermineWinnerFunc;
+			using GameAlgorithmFuncPackageBase<State, Action, _is_debug>::is_debug;
+#else
+			using GameAlgorithmFuncPackageBase<State, Action, _is_debug>::ActionList;
+			using GameAlgorithmFuncPackageBase<State, Action, _is_debug>::UpdateStateFunc;
+			using GameAlgorithmFuncPackageBase<State, Action, _is_debug>::MakeActionFunc;
+			using GameAlgorithmFuncPackageBase<State, Action, _is_debug>::DetermineWinnerFunc;
+#endif
+			using Node					= MctsNode<State, Action, Result, _is_debug>;
+			using NodePtrList			= std::vector<Node*>;
+			using StateToResultFunc		= std::function<Result(const State&, AgentIndex)>;
+			using AllowUpdateValueFunc	= std::function<bool(const State&, const Result&)>;
+			using TreePolicyValueFunc	= std::function<UcbValue(const Node&, const Node&)>;
+			using DefaultPolicyFunc		= std::function<const Action&(const ActionList&)>;
+			using AllowExtendFunc		= std::function<bool(const Node&)>;
+			using RootSelectionFunc		= std::function<size_t(const Node& root)>;
+			using StateHashFunc			= std::function<uint64_t(const State&)>;
+			using ChanceList			= std::vector<MctsChance<Action>>;
+			using ChanceOutcomesFunc	= std::function<void(const State&, ChanceList&)>;
+			using EvaluateRolloutFunc	= std::function<double(const State&, const State&)>;
+			using ResultRewardFunc		= std::function<double(const State&, const Result&)>;
+			using ActingAgentFunc		= std::function<AgentIndex(const State&)>;
+			using DefaultPolicyBase		= MctsPolicyBase<State, Action, Result, _is_debug>;		//provides default functions.
+
+		public:
+			//necessary functions.
+			const StateToResultFunc		StateToResult;		//get a result from state and winner.
+			const AllowUpdateValueFunc	AllowUpdateValue;	//update values in the node by the result.
+
+			//default functions.
+			TreePolicyValueFunc			TreePolicyValue;	//value of child node in selection process. the highest would be seleced.
+			DefaultPolicyFunc			DefaultPolicy;		//the default policy to select action.
+			AllowExtendFunc				AllowExtend;		//allow node to extend child node.
+			RootSelectionFunc			RootSelection;		//select best action of root node after iterations finished.
+			StateHashFunc				StateHash;			//hash of state, which should be set if transposition table is enabled.
+			ChanceOutcomesFunc			ChanceOutcomes;		//outcomes of chance state, which should be set if the game has chance nodes.
+			EvaluateRolloutFunc			EvaluateRollout;	//reward of truncated simulation, which should be set if simulation_cutoff_length is set.
+			ResultRewardFunc			ResultReward;		//reward of the result for the player who acts in the state, which is given by AllowUpdateValue by default.
+			ActingAgentFunc				ActingAgent;		//agent who acts in the state, truncated simulation is evaluated once for each agent if it is set.
+
+		public:
+			explicit MctsFuncPackage(
+				UpdateStateFunc			_UpdateState,
+				MakeActionFunc			_MakeAction,
+				DetermineWinnerFunc		_DetermineWinner,
+				StateToResultFunc		_StateToResult,
+				AllowUpdateValueFunc	_AllowUpdateValue,
+				TreePolicyValueFunc		_TreePolicyValue,
+				DefaultPolicyFunc		_DefaultPolicy,
+				AllowExtendFunc			_AllowExtend,
+				RootSelectionFunc		_RootSelection
+			) :
+				GameAlgorithmFuncPackageBase<State, Action, _is_debug>(_UpdateState, _MakeAction, _DetermineWinner),
+				StateToResult(_StateToResult),
+				AllowUpdateValue(_AllowUpdateValue),
+				TreePolicyValue(_TreePolicyValue),
+				DefaultPolicy(_DefaultPolicy),
+				AllowExtend(_AllowExtend),
+				RootSelection(_RootSelection),
+				StateHash(DefaultPolicyBase::StateHash),
+				ChanceOutcomes(DefaultPolicyBase::ChanceOutcomes),
+				EvaluateRollout(DefaultPolicyBase::EvaluateRollout),
+				ResultReward([_AllowUpdateValue](const State& state, const Result& result)->double { return _AllowUpdateValue(state, result) ? 1 : 0; }),
+				ActingAgent(DefaultPolicyBase::ActingAgent)
+			{
+			}
+
+			explicit MctsFuncPackage(
+				UpdateStateFunc			_UpdateState,
+				MakeActionFunc			_MakeAction,
+				DetermineWinnerFunc		_DetermineWinner,
+				StateToResultFunc		_StateToResult,
+				AllowUpdateValueFunc	_AllowUpdateValue
+			) :
+				GameAlgorithmFuncPackageBase<State, Action, _is_debug>(_UpdateState, _MakeAction, _DetermineWinner),
+				StateToResult(_StateToResult),
+				AllowUpdateValue(_AllowUpdateValue),
+				TreePolicyValue(DefaultPolicyBase::template TreePolicyValue<Node>),
+				DefaultPolicy(DefaultPolicyBase::DefaultPolicy),
+				AllowExtend(DefaultPolicyBase::template AllowExtend<Node>),
+				RootSelection(DefaultPolicyBase::template RootSelection<Node>),
+				StateHash(DefaultPolicyBase::StateHash),
+				ChanceOutcomes(DefaultPolicyBase::ChanceOutcomes),
+				EvaluateRollout(DefaultPolicyBase::EvaluateRollout),
+				ResultReward([_AllowUpdateValue](const State& state, const Result& result)->double { return _AllowUpdateValue(state, result) ? 1 : 0; }),
+				ActingAgent(DefaultPolicyBase::ActingAgent)
+			{
+			}
+		};
+
+		//constexpr values of compact tree.
+		constexpr uint32_t MCTS_COMPACT_ROOT_INDEX = 0;						//index of root node.
+		constexpr uint32_t MCTS_COMPACT_NULL_INDEX = UINT32_MAX;			//index of nonexistent node.
+		constexpr uint32_t MCTS_COMPACT_UNKNOWN_ACTION_COUNT = UINT32_MAX;	//actions of the node are not generated yet.
+
+		/*
+		* MctsCompactTree is the search tree of MCTS that is stored as structure of arrays.
+		*
+		* statistics, topology and actions of all nodes are kept in contiguous pools and nodes are referred by index.
+		* the children of a node are allocated as one block, child[i] is the node that is reached by action[i].
+		* states are not stored, they are recomputed along the selection path from the root state, and replayed
+		* from the root state again in back propagation to give the reward of each level.
+		* the tree policy is called with NodeView, which provides visit_count and win_count of the node.
+		*
+		* [State] is the game-state class, which is defined by the user.
+		* [Action] is the game-action class, which is defined by the user.
+		* [Result] is the game-result class, which stand for a terminal state of the game.
+		* [is_debug] means some debug info would not be ignored if it is true. this may result in a little degradation of performance.
+		*/
+		template<typename State, typename Action, typename Result, bool _is_debug>
+		class MctsCompactTree
+		{
+		public:
+			using NodeIndex		= uint32_t;												//index of node.
+			using FuncPackage	= MctsFuncPackage<State, Action, Result, _is_debug>;	//function package
+			using ActionList	= typename FuncPackage::ActionList;						//ActionList is the list of available actions.
+			using Node			= MctsNode<State, Action, Result, _is_debug>;			//linked node, which is used by the default tree policy of function package.
+
+			//view of a node in compact tree, which provides the statistics for tree policy.
+			class NodeView
+			{
+			private:
+				const MctsCompactTree&	_tree;
+				const NodeIndex			_index;
+
+			public:
+				NodeView(const MctsCompactTree& tree, NodeIndex index) :
+					_tree(tree),
+					_index(index)
+				{
+				}
+
+				inline uint32_t		visit_count()	const { return _tree._visit_count[_index]; }
+				inline MctsReward	win_count()		const { return _tree._win_count[_index]; }
+				inline double		avg_reward()	const { return visit_count() > 0 ? static_cast<double>(win_count()) / static_cast<double>(visit_count()) : 0; }
+			};
+
+		private:
+			//statistics of nodes.
+			std::vector<uint32_t>	_visit_count;		//how many times that the node had been visited.
+			std::vector<MctsReward>	_win_count;			//reward accmulated by the simulation.
+			std::vector<AgentIndex>	_winner_index;		//the winner index of the state.
+
+			//topology of nodes.
+			std::vector<NodeIndex>	_parent_node;		//index of parent node.
+			std::vector<NodeIndex>	_fir_child_node;	//index of the first node in the child block.
+			std::vector<uint32_t>	_child_count;		//count of expanded child nodes.
+			std::vector<uint32_t>	_fir_action;		//index of the first action in action pool.
+			std::vector<uint32_t>	_action_count;		//count of actions.
+
+			//pools.
+			std::vector<Action>		_action_pool;		//actions of all nodes.
+			const size_t			_max_node;			//max count of nodes.
+
+			//buffers that are reused by iterations.
+			std::vector<NodeIndex>	_path;				//selected nodes from root.
+			ActionList				_action_buffer;		//buffer of generated actions.
+
+		private:
+			//allocate a block of unexpanded nodes, return the index of first node or MCTS_COMPACT_NULL_INDEX if the tree is full.
+			NodeIndex allocate_block(NodeIndex parent, size_t count)
+			{
+				if (size() + count > _max_node)
+					return MCTS_COMPACT_NULL_INDEX;
+				NodeIndex fir = static_cast<NodeIndex>(size());
+				size_t new_size = size() + count;
+				_visit_count.resize(new_size, 0);
+				_win_count.resize(new_size, 0);
+				_winner_index.resize(new_size, 0);
+				_parent_node.resize(new_size, parent);
+				_fir_child_node.resize(new_size, MCTS_COMPACT_NULL_INDEX);
+				_child_count.resize(new_size, 0);
+				_fir_action.resize(new_size, 0);
+				_action_count.resize(new_size, MCTS_COMPACT_UNKNOWN_ACTION_COUNT);
+				return fir;
+			}
+
+			//the action that reaches the node from its parent.
+			inline const Action& action_of(NodeIndex node) const
+			{
+				const NodeIndex parent = _parent_node[node];
+				return _action_pool[_fir_action[parent] + (node - _fir_child_node[parent])];
+			}
+
+			//generate actions of the node and append them to action pool.
+			template<typename Policy>
+			void generate_actions(NodeIndex node, const State& state, const Policy& func)
+			{
+				if (is_debug())
+				{
+					typename FuncPackage::ChanceList chances;
+					func.ChanceOutcomes(state, chances);
+					GADT_WARNING_IF(is_debug(), !chances.empty(), "MCTS112: chance state is not supported by compact storage.");
+				}
+				_action_buffer.clear();
+				func.MakeAction(state, _action_buffer);
+				_fir_action[node] = static_cast<uint32_t>(_action_pool.size());
+				_action_count[node] = static_cast<uint32_t>(_action_buffer.size());
+				_action_pool.insert(_action_pool.end(), _action_buffer.begin(), _action_buffer.end());
+			}
+
+			//the tree policy of the policy if it accepts NodeView.
+			template<typename Policy>
+			static auto TreePolicyValueOf(const Policy& func, const NodeView& parent, const NodeView& child, int) -> decltype(func.TreePolicyValue(parent, child))
+			{
+				return func.TreePolicyValue(parent, child);
+			}
+
+			//the default tree policy, which is used if the tree policy only accepts linked nodes. it is only reached by
+			//the default tree policy of function package, see SupportTreePolicy.
+			template<typename Policy>
+			static UcbValue TreePolicyValueOf(const Policy&, const NodeView& parent, const NodeView& child, long)
+			{
+				return MctsPolicyBase<State, Action, Result, _is_debug>::TreePolicyValue(parent, child);
+			}
+
+			//tree policy accepts NodeView.
+			template<typename Policy>
+			static auto AcceptNodeView(const Policy& func, int) -> decltype(func.TreePolicyValue(std::declval<NodeView>(), std::declval<NodeView>()), bool())
+			{
+				return true;
+			}
+
+			template<typename Policy>
+			static bool AcceptNodeView(const Policy&, long)
+			{
+				return false;
+			}
+
+			//select the child with the highest tree policy value.
+			template<typename Policy>
+			NodeIndex select_child(NodeIndex node, const Policy& func) const
+			{
+				const NodeIndex fir = _fir_child_node[node];
+				const NodeIndex last = fir + _child_count[node];
+				const NodeView parent(*this, node);
+				NodeIndex best_child = fir;
+				UcbValue best_value = 0;
+				for (NodeIndex child = fir; child < last; child++)
+				{
+					UcbValue value = TreePolicyValueOf(func, parent, NodeView(*this, child), 0);
+					if (value > best_value)
+					{
+						best_child = child;
+						best_value = value;
+					}
+				}
+				return best_child;
+			}
+
+			//simulation is run from the state according to the default policy to produce a result.
+			//truncated is set if the simulation is stopped by simulation_cutoff_length, the state is left to be evaluated.
+			template<typename Policy>
+			Result Simulation(State& state, const Policy& func, const MctsSetting& setting, bool& truncated)
+			{
+				for (size_t i = 0;; i++)
+				{
+					GADT_WARNING_IF(is_debug(), i > setting.simulation_warning_length, "MCTS103: out of default policy process max length.");
+					AgentIndex winner = func.DetermineWinner(state);
+					if (winner != setting.no_winner_index)
+					{
+						return func.StateToResult(state, winner);
+					}
+					if (setting.simulation_cutoff_length > 0 && i >= setting.simulation_cutoff_length)
+					{
+						truncated = true;
+						return func.StateToResult(state, setting.no_winner_index);
+					}
+					_action_buffer.clear();
+					func.MakeAction(state, _action_buffer);
+					GADT_WARNING_IF(is_debug(), _action_buffer.size() == 0, "empty action list.");
+					const Action& action = func.DefaultPolicy(_action_buffer);
+					func.UpdateState(state, action);
+				}
+				return func.StateToResult(state, setting.no_winner_index);
+			}
+
+			//1. select the most urgent expandable node, 2. expand it and 3. run simulation from the new node.
+			template<typename Policy>
+			Result TreePolicy(State& state, const Policy& func, const MctsSetting& setting, bool& truncated, bool& out_of_memory)
+			{
+				NodeIndex node = MCTS_COMPACT_ROOT_INDEX;
 				for (;;)
 				{
-					if (child != nullptr)
+					_visit_count[node]++;
+					if (_winner_index[node] != setting.no_winner_index)
+					{
+						return func.StateToResult(state, _winner_index[node]);
+					}
+					if (_action_count[node] == MCTS_COMPACT_UNKNOWN_ACTION_COUNT)
 					{
-						child_list.push_back(child);
-						child = child->brother_node();
+						generate_actions(node, state, func);
 					}
-					else
+					GADT_WARNING_IF(is_debug(), _action_count[node] == 0, "MCTS106: empty action set during tree policy.");
+					if (_action_count[node] == 0)
 					{
-						return child_list;
+						return func.StateToResult(state, setting.no_winner_index);
 					}
+					if (_child_count[node] < _action_count[node])
+					{
+						if (_fir_child_node[node] == MCTS_COMPACT_NULL_INDEX)
+						{
+							NodeIndex fir = allocate_block(node, _action_count[node]);
+							if (fir == MCTS_COMPACT_NULL_INDEX)
+							{
+								out_of_memory = true;
+								return func.StateToResult(state, setting.no_winner_index);
+							}
+							_fir_child_node[node] = fir;
+						}
+						NodeIndex child = _fir_child_node[node] + _child_count[node];
+						func.UpdateState(state, _action_pool[_fir_action[node] + _child_count[node]]);
+						_child_count[node]++;
+						_visit_count[child] = 1;
+						_winner_index[child] = func.DetermineWinner(state);
+						_path.push_back(child);
+						if (_winner_index[child] != setting.no_winner_index)
+						{
+							return func.StateToResult(state, _winner_index[child]);
+						}
+						return Simulation(state, func, setting, truncated);
+					}
+					NodeIndex child = select_child(node, func);
+					func.UpdateState(state, action_of(child));
+					_path.push_back(child);
+					node = child;
 				}
-				return child_list;
+				return func.StateToResult(state, setting.no_winner_index);
+			}
+
+		public:
+			//constructor, the root node would be created with the actions given.
+			template<typename Policy>
+			MctsCompactTree(const State& root_state, const ActionList& root_actions, size_t max_node, const Policy& func) :
+				_max_node(max_node > 0 ? max_node : 1)
+			{
+				_visit_count.reserve(_max_node);
+				_win_count.reserve(_max_node);
+				_winner_index.reserve(_max_node);
+				_parent_node.reserve(_max_node);
+				_fir_child_node.reserve(_max_node);
+				_child_count.reserve(_max_node);
+				_fir_action.reserve(_max_node);
+				_action_count.reserve(_max_node);
+				allocate_block(MCTS_COMPACT_NULL_INDEX, 1);
+				_visit_count[MCTS_COMPACT_ROOT_INDEX] = 1;
+				_winner_index[MCTS_COMPACT_ROOT_INDEX] = func.DetermineWinner(root_state);
+				_fir_action[MCTS_COMPACT_ROOT_INDEX] = 0;
+				_action_count[MCTS_COMPACT_ROOT_INDEX] = static_cast<uint32_t>(root_actions.size());
+				_action_pool = root_actions;
 			}
 
-			//set visted count of this node.
-			void set_visit_count(uint32_t value)
+			MctsCompactTree(const MctsCompactTree&) = delete;
+
+			//execute one iteration from root state, return false if the tree is full.
+			template<typename Policy>
+			bool Iteration(const State& root_state, const Policy& func, const MctsSetting& setting)
 			{
-				_visit_count = value;
+				_path.clear();
+				_path.push_back(MCTS_COMPACT_ROOT_INDEX);
+				State state = root_state;
+				bool truncated = false;
+				bool out_of_memory = false;
+				Result result = TreePolicy(state, func, setting, truncated, out_of_memory);
+				if (out_of_memory)
+				{
+					//revert the visits of this iteration.
+					for (NodeIndex node : _path) { _visit_count[node]--; }
+					return false;
+				}
+
+				//4. back propagation, the reward of each node is given by the state of its parent, which is replayed from root state.
+				//the reward of truncated simulation is given by EvaluateRollout.
+				MctsRollout<State, Result> rollout{ result, std::move(state), truncated, {} };
+				State parent_state = root_state;
+				for (size_t i = 1; i < _path.size(); i++)
+				{
+					_win_count[_path[i]] += RolloutReward(func, parent_state, rollout);
+					if (i + 1 < _path.size())
+						func.UpdateState(parent_state, action_of(_path[i]));
+				}
+				return true;
 			}
 
-			//set wion count of this node.
-			void set_win_count(uint32_t value)
+			//the tree policy of function package is only supported if it is the default one.
+			static bool SupportTreePolicy(const FuncPackage& func)
 			{
-				_win_count = value;
+				using DefaultTreePolicy = UcbValue(*)(const Node&, const Node&);
+				const DefaultTreePolicy* target = func.TreePolicyValue.template target<DefaultTreePolicy>();
+				return target != nullptr && *target == &MctsPolicyBase<State, Action, Result, _is_debug>::template TreePolicyValue<Node>;
 			}
 
-			//return the value of _is_debug.
-			constexpr inline bool is_debug() const
+			//the tree policy of static policy is supported if it accepts NodeView.
+			template<typename Policy>
+			static bool SupportTreePolicy(const Policy& func)
 			{
-				return _is_debug;
+				return AcceptNodeView(func, 0);
 			}
-		};
 
-		/*
-		* MctsFuncPackage include all necessary functions for MCTS.
-		*
-		* use MctsFuncPackage(...) to construct a new function package.
-		*/
-		template<typename State, typename Action, typename Result, bool _is_debug>
-		struct MctsFuncPackage final : public GameAlgorithmFuncPackageBase<State, Action, _is_debug>
-		{
-		public:
-#ifdef __GADT_GNUC
-			using ActionList = typename GameAlgorithmFuncPackageBase<State, Action, _is_debug>::ActionList;
-			using UpdateStateFunc = typename GameAlgorithmFuncPackageBase<State, Action, _is_debug>::UpdateStateFunc;
-			using MakeActionFunc = typename GameAlgorithmFuncPackageBase<State, Action, _is_debug>::MakeActionFunc;
-			using DetermineWinnerFunc = typename GameAlgorithmFuncPackageBase<State, Action, _is_debug>::DetermineWinnerFunc;
-			using GameAlgorithmFuncPackageBase<State, Action, _is_debug>::is_debug;
-#else
-			using GameAlgorithmFuncPackageBase<State, Action, _is_debug>::ActionList;
-			using GameAlgorithmFuncPackageBase<State, Action, _is_debug>::UpdateStateFunc;
-			using GameAlgorithmFuncPackageBase<State, Action, _is_debug>::MakeActionFunc;
-			using GameAlgorithmFuncPackageBase<State, Action, _is_debug>::DetermineWinnerFunc;
-#endif
-			using Node					= MctsNode<State, Action, Result, _is_debug>;
-			using NodePtrList			= std::vector<Node*>;
-			using StateToResultFunc		= std::function<Result(const State&, AgentIndex)>;
-			using AllowUpdateValueFunc	= std::function<bool(const State&, const Result&)>;
-			using TreePolicyValueFunc	= std::function<UcbValue(const Node&, const Node&)>;
-			using DefaultPolicyFunc		= std::function<const Action&(const ActionList&)>;
-			using AllowExtendFunc		= std::function<bool(const Node&)>;
-			using RootSelectionFunc		= std::function<size_t(const Node& root)>;
+			//count of nodes, include the reserved child nodes.
+			inline size_t size() const { return _visit_count.size(); }
 
-		public:
-			//necessary functions.
-			const StateToResultFunc		StateToResult;		//get a result from state and winner.
-			const AllowUpdateValueFunc	AllowUpdateValue;	//update values in the node by the result.
+			//max count of nodes.
+			inline size_t max_size() const { return _max_node; }
 
-			//default functions.
-			TreePolicyValueFunc			TreePolicyValue;	//value of child node in selection process. the highest would be seleced.
-			DefaultPolicyFunc			DefaultPolicy;		//the default policy to select action.
-			AllowExtendFunc				AllowExtend;		//allow node to extend child node.
-			RootSelectionFunc			RootSelection;		//select best action of root node after iterations finished.
+			//count of expanded child nodes of the node.
+			inline uint32_t child_count(NodeIndex node) const { return _child_count[node]; }
 
-		public:
-			explicit MctsFuncPackage(
-				UpdateStateFunc			_UpdateState,
-				MakeActionFunc			_MakeAction,
-				DetermineWinnerFunc		_DetermineWinner,
-				StateToResultFunc		_StateToResult,
-				AllowUpdateValueFunc	_AllowUpdateValue,
-				TreePolicyValueFunc		_TreePolicyValue,
-				DefaultPolicyFunc		_DefaultPolicy,
-				AllowExtendFunc			_AllowExtend,
-				RootSelectionFunc		_RootSelection
-			) :
-				GameAlgorithmFuncPackageBase<State, Action, _is_debug>(_UpdateState, _MakeAction, _DetermineWinner),
-				StateToResult(_StateToResult),
-				AllowUpdateValue(_AllowUpdateValue),
-				TreePolicyValue(_TreePolicyValue),
-				DefaultPolicy(_DefaultPolicy),
-				AllowExtend(_AllowExtend),
-				RootSelection(_RootSelection)
-			{
-			}
+			//index of the child node.
+			inline NodeIndex child_node(NodeIndex node, size_t index) const { return _fir_child_node[node] + static_cast<NodeIndex>(index); }
 
-			explicit MctsFuncPackage(
-				UpdateStateFunc			_UpdateState,
-				MakeActionFunc			_MakeAction,
-				DetermineWinnerFunc		_DetermineWinner,
-				StateToResultFunc		_StateToResult,
-				AllowUpdateValueFunc	_AllowUpdateValue
-			) :
-				GameAlgorithmFuncPackageBase<State, Action, _is_debug>(_UpdateState, _MakeAction, _DetermineWinner),
-				StateToResult(_StateToResult),
-				AllowUpdateValue(_AllowUpdateValue),
-				TreePolicyValue([](const Node& parent, const Node& child)->UcbValue {
-					UcbValue avg = static_cast<UcbValue>(child.win_count()) / static_cast<UcbValue>(child.visit_count());
-					return policy::UCB1(avg, static_cast<UcbValue>(parent.visit_count()), static_cast<UcbValue>(child.visit_count()));
-				}),
-				DefaultPolicy([](const ActionList& actions)->const Action&{
-					GADT_WARNING_IF(_is_debug, actions.size() == 0, "MCTS104: empty action set during default policy.");
-					return actions[rand() % actions.size()];
-				}),
-				AllowExtend([](const Node& node)->bool {
-					return true;
-				}),
-				RootSelection([](const Node& root)->size_t{
-					auto node_ptr_set = root.child_ptr_set();
-					size_t best_visit = node_ptr_set[0]->visit_count();
-					size_t best_index = 0;
-					for (size_t i = 0; i < node_ptr_set.size(); i++)
-					{
-						if (node_ptr_set[i]->visit_count() > best_visit)
-						{
-							best_visit = node_ptr_set[i]->visit_count();
-							best_index = i;
-						}
-					}
-					return best_index;
-				})
+			//visit count of node.
+			inline uint32_t visit_count(NodeIndex node) const { return _visit_count[node]; }
+
+			//win count of node.
+			inline MctsReward win_count(NodeIndex node) const { return _win_count[node]; }
+
+			//return the value of _is_debug.
+			constexpr inline bool is_debug() const
 			{
+				return _is_debug;
 			}
 		};
 
@@ -605,12 +1529,10 @@ namespace gadt
 				visual_node.add_value(CHILD_COUNT_NAME, search_node.child_count());
 				//visual_node.add_value(IS_TERMIANL_NAME, search_node.is_end_state());
 				visual_node.add_value(STATE_NAME, _StateToStr(search_node.state()));
-				auto node_ptr = search_node.fir_child_node();
-				while(node_ptr != nullptr)
+				for (size_t i = 0; i < search_node.child_count(); i++)
 				{
 					visual_node.create_child();
-					convert_node(*node_ptr, *visual_node.last_child());
-					node_ptr = node_ptr->brother_node();
+					convert_node(*search_node.child_node(i), *visual_node.last_child());
 				}
 			}
 
@@ -646,8 +1568,9 @@ namespace gadt
 		* [Action] is the game-action class, which is defined by the user.
 		* [Result] is the game-result class, which stand for a terminal state of the game.
 		* [_is_debug] decides whether debug info would be ignored or not. which may cause slight degradation in performance if it is enabled.
+		* [Policy] is the type of functions, which is MctsFuncPackage by default. a static policy derived from MctsPolicyBase can be inlined.
 		*/
-		template<typename State, typename Action, typename Result = AgentIndex, bool _is_debug = false>
+		template<typename State, typename Action, typename Result = AgentIndex, bool _is_debug = false, typename Policy = MctsFuncPackage<State, Action, Result, _is_debug>>
 		class MctsBase : public GameAlgorithmBase<State,Action,Result,_is_debug>
 		{
 //#ifdef __GADT_GNUC
@@ -673,6 +1596,7 @@ namespace gadt
 
 			using Node			= MctsNode<State, Action, Result, _is_debug>;			//searcg node.	
 			using Allocator     = typename Node::Allocator;								//allocator of nodes
+			using CompactTree	= MctsCompactTree<State, Action, Result, _is_debug>;	//search tree in compact storage.
 			using LogController = log::SearchLogger<State, Action, Result>;				//log controller
 			using JsonConvert   = MctsJsonConvertor<State, Action, Result, _is_debug>;	//json tree
 			using FuncPackage   = MctsFuncPackage<State, Action, Result, _is_debug>;	//function package.
@@ -680,8 +1604,17 @@ namespace gadt
 
 		protected:
 
-			FuncPackage		_func_package;			//function package of the search.
+			Policy			_func_package;			//function package or static policy of the search.
 			MctsSetting		_setting;				//monte carlo tree search setting.
+			std::unique_ptr<MctsTranspositionTable> _transposition_table;	//shared statistic of the same states, which is created by the search that supports it.
+
+			//reused tree, which is kept between runs by the search that supports it.
+			bool						_tree_reuse;		//keep the search tree between runs.
+			std::unique_ptr<Allocator>	_tree_allocator;	//allocator of the reused tree.
+			Node*						_tree_root;			//root node of the reused tree.
+			Node*						_root_block;		//the block that contains the root node.
+			size_t						_root_block_size;	//size of the block that contains the root node.
+			bool						_root_advanced;		//the root node had been advanced by AdvanceRoot since last run.
 
 		protected:
 
@@ -691,7 +1624,7 @@ namespace gadt
 				auto child_nodes = root_node.child_ptr_set();
 				std::vector<size_t> tree_size_set(root_node.action_count());
 				size_t total_tree_size = 0;
-				size_t total_win_count = 0;
+				MctsReward total_win_count = 0;
 				for (size_t i = 0; i < child_nodes.size(); i++)
 				{
 					tree_size_set[i] = child_nodes[i]->subtree_size();
@@ -740,34 +1673,248 @@ namespace gadt
 				tb.Print();
 			}
 
-			//single iteration.
-			void MctsIteration(Node* root_node, Allocator* allocator)
+			//merge the statistic of source tree into target tree, the child nodes are matched by their actions, so Action 
+			//must be comparable by operator==. the visited nodes that only exist in source tree are expanded in target tree by 
+			//the allocator, the nodes without visit are not merged since they have no valid value for tree policy.
+			//return false if some nodes are not merged because their actions do not exist in target tree or lack of memory.
+			bool MergeTree(Node* target, const Node* source, Allocator* allocator)
 			{
-				timer::TimePoint tp;
-				size_t iteration_time = _setting.max_iteration_per_thread;
+				bool complete = true;
+				std::vector<std::pair<Node*, const Node*>> stack = { { target, source } };
+				while (!stack.empty())
+				{
+					Node* target_node = stack.back().first;
+					const Node* source_node = stack.back().second;
+					stack.pop_back();
+					target_node->set_visit_count(target_node->visit_count() + source_node->visit_count());
+					target_node->set_win_count(target_node->win_count() + source_node->win_count());
+					for (size_t i = 0; i < source_node->child_count(); i++)
+					{
+						if (source_node->child_node(i)->visit_count() == 0)
+							continue;
+
+						//the action of the same index is tried first, which is matched if the action lists are the same.
+						const Action& action = source_node->action(i);
+						size_t index = i;
+						if (index >= target_node->action_count() || !(target_node->action(index) == action))
+						{
+							index = 0;
+							while (index < target_node->action_count() && !(target_node->action(index) == action))
+								index++;
+						}
+						if (index == target_node->action_count())
+						{
+							GADT_WARNING_IF(is_debug(), true, "MCTS109: unmatched action while merging trees.");
+							complete = false;
+							continue;
+						}
+
+						//only the matched action is expanded, whose statistic comes from the merge. all the outcomes of chance 
+						//node are expanded together, which are not visited until they are sampled.
+						if (index >= target_node->child_count())
+						{
+							Node* child = nullptr;
+							if (allocator != nullptr && target_node->is_chance_node())
+								child = target_node->ExpandChance(*allocator, _func_package, _setting) ? target_node->child_node(index) : nullptr;
+							else if (allocator != nullptr)
+								child = target_node->ExpandAction(index, *allocator, _func_package, _setting);
+							if (child == nullptr)
+							{
+								GADT_WARNING_IF(is_debug(), true, "MCTS110: run out of memory while merging trees.");
+								complete = false;
+								continue;
+							}
+							child->set_visit_count(0);
+							child->set_win_count(0);
+							index = static_cast<size_t>(child - target_node->child_node(0));
+						}
+						stack.push_back({ target_node->child_node(index), source_node->child_node(i) });
+					}
+				}
+				return complete;
+			}
+
+			//release the child nodes of the expanded nodes by the garbage collection policy, until the size of allocator 
+			//is not higher than target size. root node and its child nodes are never released. 
+			//return count of elements that had been released.
+			size_t CollectGarbage(Node* root_node, Allocator* allocator, size_t target_size)
+			{
+				const size_t origin_size = allocator->size();
+				std::vector<std::pair<Node*, size_t>> stack;
+				if (_setting.gc_policy == MctsGcPolicy::PruneLeastVisited)
+				{
+					//rank all expanded nodes by visit count, deeper nodes are released first if visit counts are equal.
+					//each expanded node records the index of its expanded parent, since a child may be visited more 
+					//than its parent, such as the statistics merged from other trees, and the nodes under a released 
+					//subtree had been destoryed.
+					struct GcEntry
+					{
+						Node*	node;
+						size_t	depth;
+						size_t	parent;		//index of the expanded parent, or NO_PARENT for the children of root.
+						bool	released;
+					};
+					const size_t NO_PARENT = SIZE_MAX;
+					std::vector<GcEntry> expanded_nodes;
+					std::vector<GcEntry> entry_stack = { { root_node, 0, NO_PARENT, false } };
+					while (!entry_stack.empty())
+					{
+						GcEntry item = entry_stack.back();
+						entry_stack.pop_back();
+						size_t parent = item.parent;
+						if (item.depth > 0 && item.node->exist_child_node())
+						{
+							parent = expanded_nodes.size();
+							expanded_nodes.push_back(item);
+						}
+						for (size_t i = 0; i < item.node->child_count(); i++)
+							entry_stack.push_back({ item.node->child_node(i), item.depth + 1, parent, false });
+					}
+					std::vector<size_t> order(expanded_nodes.size());
+					for (size_t i = 0; i < order.size(); i++)
+						order[i] = i;
+					std::sort(order.begin(), order.end(), [&](size_t fir, size_t sec)->bool {
+						const GcEntry& fir_entry = expanded_nodes[fir];
+						const GcEntry& sec_entry = expanded_nodes[sec];
+						if (fir_entry.node->visit_count() != sec_entry.node->visit_count())
+							return fir_entry.node->visit_count() < sec_entry.node->visit_count();
+						return fir_entry.depth > sec_entry.depth;
+					});
+					for (size_t index : order)
+					{
+						if (allocator->size() <= target_size)
+							break;
+						GcEntry& entry = expanded_nodes[index];
+						size_t parent = entry.parent;
+						while (parent != NO_PARENT && !expanded_nodes[parent].released)
+							parent = expanded_nodes[parent].parent;
+						entry.released = true;
+						if (parent == NO_PARENT)
+							entry.node->FreeChildNodes(*allocator);
+					}
+				}
+				else if (_setting.gc_policy == MctsGcPolicy::CollapseColdSubtrees)
+				{
+					//convert the nodes whose visit count is lower than threshold to leaves.
+					for (uint32_t threshold = 2; allocator->size() > target_size && threshold <= root_node->visit_count(); threshold *= 2)
+					{
+						stack.push_back({ root_node, 0 });
+						while (!stack.empty())
+						{
+							auto item = stack.back();
+							stack.pop_back();
+							if (item.second > 0 && item.first->visit_count() < threshold)
+							{
+								item.first->FreeChildNodes(*allocator);
+								continue;
+							}
+							for (size_t i = 0; i < item.first->child_count(); i++)
+								stack.push_back({ item.first->child_node(i), item.second + 1 });
+						}
+					}
+				}
+				return origin_size - allocator->size();
+			}
+
+			//excute iterations from the time point. garbage collection is only allowed if the tree is owned by this thread.
+			//return false if the search is stopped by timeout or memory before the iterations are finished.
+			bool MctsIteration(Node* root_node, Allocator* allocator, size_t iteration_time, const timer::TimePoint& tp, bool allow_gc = true)
+			{
+				const bool gc_enabled = allow_gc && _setting.gc_policy != MctsGcPolicy::None;
+				const size_t high_water_size = static_cast<size_t>(_setting.gc_high_water * static_cast<double>(allocator->total_size()));
+				const size_t low_water_size = static_cast<size_t>(_setting.gc_low_water * static_cast<double>(allocator->total_size()));
+				typename Node::NodePath path;	//reused by all iterations.
+				thread::ThreadPool* leaf_pool = _setting.leaf_simulations > 1 ? &thread::SharedPool() : nullptr;
 				for (size_t i = 0; i < iteration_time; i++)
 				{
 					//stop search if timout.
 					if (timeout(tp, _setting.timeout))
-						return; 
+						return false; 
 
 					//excute garbage collection if need.
-					//TODO
+					if (gc_enabled && allocator->size() >= high_water_size)
+						CollectGarbage(root_node, allocator, low_water_size);
 
 					//run out of memory, stop search.
 					if (allocator->is_full())
-						return;
+						return false;
+
+					//excute next, collect garbage if the child block can not be allocated. the memory may be fragmented, 
+					//so at least half of the nodes would be released.
+					if (!root_node->Selection(*allocator, _func_package, _setting, path, leaf_pool, _transposition_table.get()))
+					{
+						if (!gc_enabled || CollectGarbage(root_node, allocator, std::min(low_water_size, allocator->size() / 2)) == 0)
+							return false;
+					}
+				}
+				return true;
+			}
+
+			//single iteration. garbage collection is only allowed if the tree is owned by this thread.
+			void MctsIteration(Node* root_node, Allocator* allocator, bool allow_gc = true)
+			{
+				timer::TimePoint tp;
+				MctsIteration(root_node, allocator, _setting.max_iteration_per_thread, tp, allow_gc);
+			}
+
+			//single iteration with compact storage, the child nodes of root would be created by allocator after search.
+			void CompactIteration(Node* root_node, Allocator* allocator)
+			{
+				timer::TimePoint tp;
+				CompactTree tree(root_node->state(), root_node->action_list(), _setting.max_node_per_thread, _func_package);
+				for (size_t i = 0; i < _setting.max_iteration_per_thread; i++)
+				{
+					//stop search if timout.
+					if (timeout(tp, _setting.timeout))
+						break;
+
+					//run out of memory, stop search.
+					if (!tree.Iteration(root_node->state(), _func_package, _setting))
+						break;
+				}
+
+				//convert the child nodes of root to linked nodes.
+				root_node->set_visit_count(root_node->visit_count() + tree.visit_count(MCTS_COMPACT_ROOT_INDEX) - 1);
+				for (size_t i = 0; i < tree.child_count(MCTS_COMPACT_ROOT_INDEX); i++)
+				{
+					Node* child = root_node->ExpandChild(*allocator, _func_package, _setting);
+					typename CompactTree::NodeIndex compact_child = tree.child_node(MCTS_COMPACT_ROOT_INDEX, i);
+					child->set_visit_count(tree.visit_count(compact_child));
+					child->set_win_count(tree.win_count(compact_child));
+				}
+			}
 
-					//excute next.
-					root_node->Selection(*allocator, _func_package, _setting);
+			//execute iterations of a thread that owns its tree by the storage in setting.
+			void ThreadIteration(Node* root_node, Allocator* allocator)
+			{
+				if (_setting.node_storage == MctsNodeStorage::Compact)
+				{
+					CompactIteration(root_node, allocator);
+					return;
 				}
+				MctsIteration(root_node, allocator);
+			}
+
+			//reset the random generator of current thread if a seed is given in setting.
+			void SeedRandom(size_t thread_id) const
+			{
+				if (_setting.random_seed != 0)
+					random::SeedThread(random::DeriveSeed(_setting.random_seed, thread_id));
+			}
+
+			//size of the allocator of each thread that owns its tree.
+			size_t ThreadAllocatorSize(const Node& root_node) const
+			{
+				if (_setting.node_storage == MctsNodeStorage::Compact)
+					return root_node.action_count() > 0 ? root_node.action_count() : 1;
+				return _setting.max_node_per_thread;
 			}
 
 			//excute mcts iterations.
 			virtual void ExcuteIteration(Node& root_node, stl::LinearAllocator<Allocator, _is_debug>& allocators) = 0;
 
-			//excute iteration function.
-			Action ExcuteMCTS(const State& root_state)
+			//check setting and output log before search.
+			void StartMCTS()
 			{
 				//thread num must can not be 0.
 				if (_setting.max_thread == 0)
@@ -776,11 +1923,19 @@ namespace gadt
 					if (log_enabled())
 						logger() << ">> [WARNING]: max_thread can not be 0, which had been changed to 1." << std::endl;
 				}
-					
 
-				timer::TimePoint tp_start;
-				Node root_node(root_state, nullptr, _func_package, _setting);
-				stl::LinearAllocator<Allocator, _is_debug> allocators(_setting.max_thread);
+				//compact storage can not call the tree policy that only accepts linked nodes.
+				if (_setting.node_storage == MctsNodeStorage::Compact && !CompactTree::SupportTreePolicy(_func_package))
+				{
+					_setting.node_storage = MctsNodeStorage::Linked;
+					if (log_enabled())
+						logger() << ">> [WARNING]: tree policy is not supported by compact storage, which had been changed to linked storage." << std::endl;
+				}
+
+				//prepare workers of the shared pool, the calling thread is also a worker.
+				size_t worker_count = _setting.max_thread * std::max<size_t>(_setting.leaf_simulations, 1) - 1;
+				if (worker_count > 0)
+					thread::SharedPool().reserve(worker_count);
 
 				//outputt log if enabled.
 				if (log_enabled())
@@ -789,23 +1944,48 @@ namespace gadt
 					_setting.PrintInfo();
 					logger() << std::endl << ">> Executing......" << std::endl;
 				}
-				
-				//return action if there is only one action in root node.
+			}
+
+			//return true if there is only one action in root node, which would be returned without search.
+			bool IsSingleActionRoot(const Node& root_node)
+			{
 				if (root_node.action_count() == 1)
 				{
 					if (log_enabled())
 					{
 						logger() << ">> Only one action is available. action = " << _log_controller.action_to_str_func()(root_node.action(0)) << std::endl;
 					}
-					return root_node.action(0);
+					return true;
 				}
+				return false;
+			}
+
+			//excute iteration function.
+			Action ExcuteMCTS(const State& root_state)
+			{
+				//allocators must be released after root node, which destories all the nodes in the tree.
+				//an extra allocator is reserved for the nodes created after iterations, such as merged trees.
+				timer::TimePoint tp_start;
+				StartMCTS();
+				stl::LinearAllocator<Allocator, _is_debug> allocators(_setting.max_thread + 1);
+				Node root_node(root_state, nullptr, _func_package, _setting);
+				
+				//return action if there is only one action in root node.
+				if (IsSingleActionRoot(root_node))
+					return root_node.action(0);
 
 				//excute iterations.
 				ExcuteIteration(root_node, allocators);
+				return FinishMCTS(root_node, tp_start);
+			}
 
+			//select best action of root node and output the result after iterations.
+			Action FinishMCTS(Node& root_node, const timer::TimePoint& tp_start)
+			{
 				//select best action.
 				GADT_WARNING_IF(is_debug(), root_node.fir_child_node() == nullptr, "empty child node under root node.");
 				GADT_WARNING_IF(is_debug(), root_node.action_count() == 0, "no existing available action in root node.");
+				GADT_WARNING_IF(is_debug(), root_node.is_chance_node(), "MCTS113: execute search for chance state.");
 				size_t best_child_index = _func_package.RootSelection(root_node);
 
 				//output Json if enabled.
@@ -824,6 +2004,104 @@ namespace gadt
 				return root_node.action(best_child_index);
 			}
 
+			//get the root node of reused tree, a new tree would be created by an allocator of allocator_size if not exist.
+			//the tree is reused only if the state hash of the root node equals the given state, or the root node had been 
+			//advanced by AdvanceRoot if StateHash is not defined. otherwise the tree is rebuilt.
+			Node* PrepareTreeRoot(const State& root_state, size_t allocator_size)
+			{
+				if (_tree_root != nullptr)
+				{
+					const uint64_t hash = _func_package.StateHash(root_state);
+					const bool confirmed = hash != 0 ? hash == _func_package.StateHash(_tree_root->state()) : _root_advanced;
+					GADT_WARNING_IF(_is_debug, (hash == 0 && !confirmed), "MCTS114: reused tree is rebuilt since the state is unchecked without StateHash.");
+					_root_advanced = false;
+					if (confirmed)
+						return _tree_root;
+					ClearTree();
+				}
+				if (_tree_allocator == nullptr || _tree_allocator->total_size() != allocator_size)
+					_tree_allocator.reset(new Allocator(allocator_size));
+				_root_block = _tree_allocator->allocate(1);
+				_root_block_size = 1;
+				_tree_root = _tree_allocator->construct(_root_block, root_state, nullptr, _func_package, _setting);
+				_tree_root->set_visit_count(0);//visits of root node only count the iterations.
+				return _tree_root;
+			}
+
+			//keep the search tree between runs. the state of next run should be the state of current root node, which
+			//is confirmed by StateHash, or by AdvanceRoot if StateHash is not defined. otherwise the tree is rebuilt. 
+			//the tree is always stored by linked nodes.
+			inline void EnableTreeReuse()
+			{
+				_tree_reuse = true;
+			}
+
+			//disable tree reuse and release the tree.
+			inline void DisableTreeReuse()
+			{
+				_tree_reuse = false;
+				ClearTree();
+			}
+
+			//release the reused tree, next run would start from a new tree.
+			void ClearTree()
+			{
+				if (_tree_root != nullptr && _tree_allocator != nullptr)
+				{
+					_tree_root->~Node();
+					_tree_allocator->flush();
+				}
+				_tree_root = nullptr;
+				_root_block = nullptr;
+				_root_block_size = 0;
+				_root_advanced = false;
+				if (_transposition_table)
+					_transposition_table->clear();
+			}
+
+			//advance the root of reused tree to the child node reached by the action, other child nodes are reclaimed.
+			//return false if the child node is not expanded, then the tree is cleared and rebuilt in next run.
+			bool AdvanceRoot(size_t action_index)
+			{
+				if (_tree_root == nullptr)
+					return false;
+				if (action_index >= _tree_root->child_count())
+				{
+					ClearTree();
+					return false;
+				}
+				Node* old_root = _tree_root;
+				Node* old_block = _root_block;
+				size_t old_block_size = _root_block_size;
+				_root_block_size = old_root->action_count();
+				_tree_root = old_root->DetachChild(action_index, *_tree_allocator);
+				_root_block = _tree_root - action_index;
+				old_root->~Node();
+				_tree_allocator->deallocate(old_block, old_block_size);
+				_root_advanced = true;
+				return true;
+			}
+
+			//advance the root of reused tree by the action, Action must be comparable by operator==.
+			bool AdvanceRoot(const Action& action)
+			{
+				if (_tree_root == nullptr)
+					return false;
+				for (size_t i = 0; i < _tree_root->action_count(); i++)
+				{
+					if (_tree_root->action(i) == action)
+						return AdvanceRoot(i);
+				}
+				ClearTree();
+				return false;
+			}
+
+			//get the root node of reused tree, return nullptr if not exist.
+			inline const Node* tree_root() const
+			{
+				return _tree_root;
+			}
+
 		public:
 
 			//create monte carlo tree search with necessary functions. 
@@ -836,17 +2114,49 @@ namespace gadt
 			):
 				GameAlgorithmBase<State, Action, Result, _is_debug>(""),
 				_func_package( _UpdateState, _MakeAction, _DetermineWinner, _StateToResult, _AllowUpdateValue),
-				_setting()
+				_setting(),
+				_tree_reuse(false),
+				_tree_allocator(),
+				_tree_root(nullptr),
+				_root_block(nullptr),
+				_root_block_size(0),
+				_root_advanced(false)
 			{
 			}
 
 
-			//create monte carlo tree search with function package. 
-			MctsBase(FuncPackage function_package, MctsSetting setting) :
+			//create monte carlo tree search with function package or policy. 
+			MctsBase(Policy function_package, MctsSetting setting) :
 				GameAlgorithmBase<State, Action, Result, _is_debug>(""),
 				_func_package(function_package),
-				_setting(setting)
+				_setting(setting),
+				_tree_reuse(false),
+				_tree_allocator(),
+				_tree_root(nullptr),
+				_root_block(nullptr),
+				_root_block_size(0),
+				_root_advanced(false)
+			{
+			}
+
+			//create monte carlo tree search with static policy.
+			explicit MctsBase(MctsSetting setting) :
+				GameAlgorithmBase<State, Action, Result, _is_debug>(""),
+				_func_package(),
+				_setting(setting),
+				_tree_reuse(false),
+				_tree_allocator(),
+				_tree_root(nullptr),
+				_root_block(nullptr),
+				_root_block_size(0),
+				_root_advanced(false)
+			{
+			}
+
+			//destory the reused tree before its allocator.
+			virtual ~MctsBase()
 			{
+				ClearTree();
 			}
 
 			inline void Set(MctsSetting setting)
@@ -868,9 +2178,10 @@ namespace gadt
 		* [Action] is the game-action class, which is defined by the user.
 		* [Result] is the game-result class, which stand for a terminal state of the game.
 		* [_is_debug] decides whether debug info would be ignored or not. which may cause slight degradation in performance if it is enabled.
+		* [Policy] is the type of functions, which is MctsFuncPackage by default. a static policy derived from MctsPolicyBase can be inlined.
 		*/
-		template<typename State, typename Action, typename Result = AgentIndex, bool _is_debug = false>
-		class MonteCarloTreeSearch final : MctsBase<State,Action,Result, _is_debug>
+		template<typename State, typename Action, typename Result = AgentIndex, bool _is_debug = false, typename Policy = MctsFuncPackage<State, Action, Result, _is_debug>>
+		class MonteCarloTreeSearch final : MctsBase<State,Action,Result, _is_debug, Policy>
 		{
 		public:
 
@@ -881,12 +2192,25 @@ namespace gadt
 			using GameAlgorithmBase<State, Action, Result, _is_debug>::DisableLog;
 			using GameAlgorithmBase<State, Action, Result, _is_debug>::EnableJsonOutput;
 			using GameAlgorithmBase<State, Action, Result, _is_debug>::DisableJsonOutput;
-			using MctsBase<State, Action, Result, _is_debug>::_func_package;
-			using MctsBase<State, Action, Result, _is_debug>::_setting;
-			using MctsBase<State, Action, Result, _is_debug>::Set;
-			using MctsBase<State, Action, Result, _is_debug>::MctsIteration;
-			using MctsBase<State, Action, Result, _is_debug>::ExcuteIteration;
-			using MctsBase<State, Action, Result, _is_debug>::ExcuteMCTS;
+			using MctsBase<State, Action, Result, _is_debug, Policy>::_func_package;
+			using MctsBase<State, Action, Result, _is_debug, Policy>::_setting;
+			using MctsBase<State, Action, Result, _is_debug, Policy>::_transposition_table;
+			using MctsBase<State, Action, Result, _is_debug, Policy>::Set;
+			using MctsBase<State, Action, Result, _is_debug, Policy>::MctsIteration;
+			using MctsBase<State, Action, Result, _is_debug, Policy>::ThreadIteration;
+			using MctsBase<State, Action, Result, _is_debug, Policy>::SeedRandom;
+			using MctsBase<State, Action, Result, _is_debug, Policy>::ThreadAllocatorSize;
+			using MctsBase<State, Action, Result, _is_debug, Policy>::ExcuteIteration;
+			using MctsBase<State, Action, Result, _is_debug, Policy>::ExcuteMCTS;
+			using MctsBase<State, Action, Result, _is_debug, Policy>::StartMCTS;
+			using MctsBase<State, Action, Result, _is_debug, Policy>::IsSingleActionRoot;
+			using MctsBase<State, Action, Result, _is_debug, Policy>::FinishMCTS;
+			using MctsBase<State, Action, Result, _is_debug, Policy>::PrepareTreeRoot;
+			using MctsBase<State, Action, Result, _is_debug, Policy>::EnableTreeReuse;
+			using MctsBase<State, Action, Result, _is_debug, Policy>::DisableTreeReuse;
+			using MctsBase<State, Action, Result, _is_debug, Policy>::ClearTree;
+			using MctsBase<State, Action, Result, _is_debug, Policy>::AdvanceRoot;
+			using MctsBase<State, Action, Result, _is_debug, Policy>::tree_root;
 
 		private:
 
@@ -894,17 +2218,48 @@ namespace gadt
 			using Allocator = typename Node::Allocator;								//allocator of nodes
 			using FuncPackage = MctsFuncPackage<State, Action, Result, _is_debug>;	//function package.
 
+			using MctsBase<State, Action, Result, _is_debug, Policy>::_tree_reuse;
+			using MctsBase<State, Action, Result, _is_debug, Policy>::_tree_allocator;
+
 		private:
 
+			//create or clear transposition table by setting, the table is kept between runs if tree is reused.
+			void PrepareTranspositionTable()
+			{
+				if (_setting.transposition_table_size == 0 || _setting.node_storage == MctsNodeStorage::Compact)
+				{
+					_transposition_table.reset();
+					return;
+				}
+				if (!_transposition_table || _transposition_table->size() != _setting.transposition_table_size)
+					_transposition_table.reset(new MctsTranspositionTable(_setting.transposition_table_size));
+				else if (!_tree_reuse)
+					_transposition_table->clear();
+			}
+
+			//excute mcts on the reused tree, the visits of root node are accumulated between runs.
+			Action ExcuteTreeReuseMCTS(const State& root_state)
+			{
+				timer::TimePoint tp_start;
+				StartMCTS();
+				Node* root_node = PrepareTreeRoot(root_state, _setting.max_node_per_thread);
+
+				//return action if there is only one action in root node.
+				if (IsSingleActionRoot(*root_node))
+					return root_node->action(0);
+
+				SeedRandom(0);
+				MctsIteration(root_node, _tree_allocator.get());
+				return FinishMCTS(*root_node, tp_start);
+			}
+
 			//excute mcts iterations.
 			void ExcuteIteration(Node& root_node, stl::LinearAllocator<Allocator, _is_debug>& allocators) override
 			{
-				//thread content
-				std::vector<std::thread> threads;
-
 				//run iterations.
-				Allocator* allocator = allocators.construct(_setting.max_node_per_thread);
-				MctsIteration(&root_node, allocator);
+				Allocator* allocator = allocators.construct(ThreadAllocatorSize(root_node));
+				SeedRandom(0);
+				ThreadIteration(&root_node, allocator);
 
 				//delete the original visit of root node.
 				root_node.set_visit_count(root_node.visit_count() - 1);
@@ -920,14 +2275,21 @@ namespace gadt
 				typename FuncPackage::StateToResultFunc		_StateToResult,
 				typename FuncPackage::AllowUpdateValueFunc	_AllowUpdateValue
 			) :
-				MctsBase<State, Action, Result, _is_debug>(_UpdateState, _MakeAction, _DetermineWinner, _StateToResult, _AllowUpdateValue)
+				MctsBase<State, Action, Result, _is_debug, Policy>(_UpdateState, _MakeAction, _DetermineWinner, _StateToResult, _AllowUpdateValue)
+			{
+				set_name("Monte Carlo Tree Search");
+			}
+
+			//create monte carlo tree search with function package or policy. 
+			MonteCarloTreeSearch(Policy function_package, MctsSetting setting = MctsSetting()) :
+				MctsBase<State, Action, Result, _is_debug, Policy>(function_package, setting)
 			{
 				set_name("Monte Carlo Tree Search");
 			}
 
-			//create monte carlo tree search with function package. 
-			MonteCarloTreeSearch(FuncPackage function_package, MctsSetting setting = MctsSetting()) :
-				MctsBase<State, Action, Result, _is_debug>(function_package, setting)
+			//create monte carlo tree search with static policy.
+			explicit MonteCarloTreeSearch(MctsSetting setting = MctsSetting()) :
+				MctsBase<State, Action, Result, _is_debug, Policy>(setting)
 			{
 				set_name("Monte Carlo Tree Search");
 			}
@@ -937,6 +2299,9 @@ namespace gadt
 			{
 				_setting = MctsSetting();
 				_setting.max_thread = 1;
+				PrepareTranspositionTable();
+				if (_tree_reuse)
+					return ExcuteTreeReuseMCTS(root_state);
 				return ExcuteMCTS(root_state);
 			}
 
@@ -945,8 +2310,20 @@ namespace gadt
 			{
 				_setting = setting;
 				_setting.max_thread = 1;
+				PrepareTranspositionTable();
+				if (_tree_reuse)
+					return ExcuteTreeReuseMCTS(root_state);
 				return ExcuteMCTS(root_state);
 			}
 		};
+
+		/*
+		* StaticMonteCarloTreeSearch is MonteCarloTreeSearch with a static policy, whose types are defined by the policy.
+		*
+		* [Policy] is the policy type derived from MctsPolicyBase.
+		* [_is_debug] decides whether debug info would be ignored or not. which may cause slight degradation in performance if it is enabled.
+		*/
+		template<typename Policy, bool _is_debug = false>
+		using StaticMonteCarloTreeSearch = MonteCarloTreeSearch<typename Policy::State, typename Policy::Action, typename Policy::Result, _is_debug, Policy>;
 	}
-}
\ No newline at end of file
+}
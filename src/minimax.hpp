@@ -21,6 +21,7 @@
 
 #include "gadtlib.h"
 #include "gadt_algorithm.hpp"
+#include "gadt_thread.hpp"
 
 #pragma once
 
@@ -38,6 +39,27 @@ namespace gadt
 
 		using MinimaxEvalType = double;
 
+		//the clock is checked once per (mask + 1) nodes when the search can be stopped by timeout.
+		constexpr size_t GADT_MINIMAX_TIMEOUT_CHECK_MASK = 0x3FF;
+
+		//count of entries in a bucket of transposition table.
+		constexpr size_t GADT_MINIMAX_TT_BUCKET_SIZE = 2;
+
+		//count of killer moves kept for each ply.
+		constexpr size_t GADT_MINIMAX_KILLER_SLOTS = 2;
+
+		//count of entries in history table, action keys are mapped into it by modulo.
+		constexpr size_t GADT_MINIMAX_HISTORY_SIZE = 4096;
+
+		//bound type of the score in transposition table.
+		enum class MinimaxBound : uint8_t
+		{
+			None = 0,	//empty entry.
+			Exact = 1,	//score is the exact value.
+			Lower = 2,	//score is the lower bound of the value, which is caused by beta cut.
+			Upper = 3	//score is the upper bound of the value, which means all child nodes failed low.
+		};
+
 		/*
 		* MinimaxSetting is the setting of MCTS.
 		*
@@ -47,11 +69,23 @@ namespace gadt
 		struct MinimaxSetting final : GameAlgorithmSettingBase
 		{
 			size_t max_depth;
+			size_t transposition_table_size;	//count of entries in transposition table, 0 means disabled.
+			bool iterative_deepening;			//search depth 1, 2, 3... until max_depth or timeout.
+			bool move_ordering;					//order actions by killer moves, history heuristic and ScoreAction.
+			size_t thread_count;				//count of searching threads, which share the transposition table.
+			bool principal_variation_search;	//search the actions after the first one with null window, and re-search if they fail high.
+			double aspiration_window;			//half width of the root window around the eval of previous iteration, 0 means disabled.
 
 			//default setting constructor.
 			MinimaxSetting() :
 				GameAlgorithmSettingBase(),
-				max_depth(2)
+				max_depth(2),
+				transposition_table_size(0),
+				iterative_deepening(false),
+				move_ordering(false),
+				thread_count(1),
+				principal_variation_search(false),
+				aspiration_window(0)
 			{
 			}
 
@@ -62,22 +96,272 @@ namespace gadt
 				AgentIndex _no_winner_index = GADT_DEFAULT_NO_WINNER_INDEX
 			) :
 				GameAlgorithmSettingBase(_timeout, _no_winner_index),
-				max_depth(_max_depth)
+				max_depth(_max_depth),
+				transposition_table_size(0),
+				iterative_deepening(false),
+				move_ordering(false),
+				thread_count(1),
+				principal_variation_search(false),
+				aspiration_window(0)
 			{
 			}
 
 			void PrintInfo() const override
 			{
-				console::Table tb(2, 3);
+				console::Table tb(2, 9);
 				tb.set_width({ 12,6 });
 				tb.enable_title({ "MINIMAX SETTING" });
 				tb.set_cell_in_row(0, { { "timeout" },			{ ToString(timeout) } });
 				tb.set_cell_in_row(1, { { "max_depth" },		{ ToString(max_depth) } });
 				tb.set_cell_in_row(2, { { "no_winner_index" },	{ ToString(no_winner_index) } });
+				tb.set_cell_in_row(3, { { "tt_size" },			{ ToString(transposition_table_size) } });
+				tb.set_cell_in_row(4, { { "iterative_deepening" },	{ ToString(iterative_deepening) } });
+				tb.set_cell_in_row(5, { { "move_ordering" },	{ ToString(move_ordering) } });
+				tb.set_cell_in_row(6, { { "thread_count" },		{ ToString(thread_count) } });
+				tb.set_cell_in_row(7, { { "pvs" },				{ ToString(principal_variation_search) } });
+				tb.set_cell_in_row(8, { { "aspiration_window" },	{ ToString(aspiration_window) } });
 				tb.Print();
 			}
 		};
 
+		/*
+		* MinimaxTranspositionTable is a fixed-size hash table of searched states used by minimax search.
+		*
+		* entries are grouped into buckets aligned with cache line, so that a probe only touches one cache line.
+		* each entry is stored as words xor-ed with the key, a torn entry written by another thread fails the
+		* verification and is treated as a miss, so the table can be shared by threads without lock.
+		*
+		* [EvalType] is the type of score, which should be trivially copyable and no more than 8 bytes.
+		*/
+		template<typename EvalType>
+		class MinimaxTranspositionTable final
+		{
+		public:
+			static_assert(sizeof(EvalType) <= sizeof(uint64_t) && std::is_trivially_copyable<EvalType>::value, "EvalType is not supported by transposition table.");
+
+			//value of best index if there is no best action.
+			static constexpr size_t NO_INDEX = 0xFFFFFFFF;
+
+			struct Entry
+			{
+				EvalType		score;
+				size_t			depth;
+				MinimaxBound	bound;
+				size_t			best_index;
+			};
+
+		private:
+			struct Slot
+			{
+				std::atomic<uint64_t> check;	//key ^ score ^ info.
+				std::atomic<uint64_t> score;
+				std::atomic<uint64_t> info;		//best index(32 bits) | depth(24 bits) | bound(8 bits).
+			};
+
+			struct alignas(GADT_CACHE_LINE_SIZE) Bucket
+			{
+				Slot slots[GADT_MINIMAX_TT_BUCKET_SIZE];
+			};
+
+			std::vector<Bucket, stl::AlignedAllocator<Bucket>> _buckets;	//std::allocator may ignore the alignment of bucket.
+
+		private:
+			inline Bucket& bucket(uint64_t key)
+			{
+				return _buckets[static_cast<size_t>((key ^ (key >> 32)) % _buckets.size())];
+			}
+
+			inline const Bucket& bucket(uint64_t key) const
+			{
+				return _buckets[static_cast<size_t>((key ^ (key >> 32)) % _buckets.size())];
+			}
+
+			static inline uint64_t ScoreToBits(EvalType score)
+			{
+				uint64_t bits = 0;
+				memcpy(&bits, &score, sizeof(EvalType));
+				return bits;
+			}
+
+			static inline EvalType BitsToScore(uint64_t bits)
+			{
+				EvalType score;
+				memcpy(&score, &bits, sizeof(EvalType));
+				return score;
+			}
+
+			static inline size_t InfoDepth(uint64_t info)
+			{
+				return static_cast<size_t>((info >> 8) & 0xFFFFFF);
+			}
+
+			//load the slot, return false if it is empty or does not belong to the key.
+			static inline bool LoadSlot(const Slot& slot, uint64_t key, uint64_t& score, uint64_t& info)
+			{
+				score = slot.score.load(std::memory_order_relaxed);
+				info = slot.info.load(std::memory_order_relaxed);
+				return (slot.check.load(std::memory_order_relaxed) ^ score ^ info) == key && (info & 0xFF) != 0;
+			}
+
+		public:
+			explicit MinimaxTranspositionTable(size_t size) :
+				_buckets(ActualSize(size) / GADT_MINIMAX_TT_BUCKET_SIZE)
+			{
+				clear();
+			}
+
+			//get the count of entries in the table created with the size, which is rounded to whole buckets.
+			static size_t ActualSize(size_t size)
+			{
+				return (size > GADT_MINIMAX_TT_BUCKET_SIZE ? size / GADT_MINIMAX_TT_BUCKET_SIZE : 1) * GADT_MINIMAX_TT_BUCKET_SIZE;
+			}
+
+			//get the entry of the key, return false if it does not exist.
+			bool probe(uint64_t key, Entry& entry) const
+			{
+				for (const Slot& slot : bucket(key).slots)
+				{
+					uint64_t score, info;
+					if (LoadSlot(slot, key, score, info))
+					{
+						entry.score = BitsToScore(score);
+						entry.depth = InfoDepth(info);
+						entry.bound = static_cast<MinimaxBound>(info & 0xFF);
+						entry.best_index = static_cast<size_t>(info >> 32);
+						return true;
+					}
+				}
+				return false;
+			}
+
+			//store the result of a search, the entry of the same key or the shallowest entry in the bucket is replaced.
+			void store(uint64_t key, EvalType score, size_t depth, MinimaxBound bound, size_t best_index)
+			{
+				Bucket& target = bucket(key);
+				Slot* replace = &target.slots[0];
+				size_t replace_depth = SIZE_MAX;
+				for (Slot& slot : target.slots)
+				{
+					uint64_t old_score, old_info;
+					if (LoadSlot(slot, key, old_score, old_info))
+					{
+						replace = &slot;
+						break;
+					}
+					size_t slot_depth = (old_info & 0xFF) == 0 ? 0 : InfoDepth(old_info);
+					if (slot_depth < replace_depth)
+					{
+						replace = &slot;
+						replace_depth = slot_depth;
+					}
+				}
+				const uint64_t score_bits = ScoreToBits(score);
+				const uint64_t info =
+					(static_cast<uint64_t>(best_index < NO_INDEX ? best_index : NO_INDEX) << 32) |
+					(static_cast<uint64_t>(depth < 0xFFFFFF ? depth : 0xFFFFFF) << 8) |
+					static_cast<uint64_t>(bound);
+				replace->check.store(key ^ score_bits ^ info, std::memory_order_relaxed);
+				replace->score.store(score_bits, std::memory_order_relaxed);
+				replace->info.store(info, std::memory_order_relaxed);
+			}
+
+			//remove all entries.
+			void clear()
+			{
+				for (Bucket& target : _buckets)
+				{
+					for (Slot& slot : target.slots)
+					{
+						slot.check.store(0, std::memory_order_relaxed);
+						slot.score.store(0, std::memory_order_relaxed);
+						slot.info.store(0, std::memory_order_relaxed);
+					}
+				}
+			}
+
+			//get the count of entries.
+			size_t size() const
+			{
+				return _buckets.size() * GADT_MINIMAX_TT_BUCKET_SIZE;
+			}
+		};
+
+		template<typename EvalType>
+		constexpr size_t MinimaxTranspositionTable<EvalType>::NO_INDEX;
+
+		/*
+		* MinimaxMoveOrdering keeps the killer moves and history heuristic of a search.
+		*
+		* killer moves are the actions which caused beta cut in the sibling nodes of the same ply.
+		* history is the total bonus of the actions which caused beta cut in any node, deeper cut gets more bonus.
+		* actions are identified by the keys from ActionKey function.
+		*/
+		class MinimaxMoveOrdering final
+		{
+		public:
+			//key of empty killer slot.
+			static constexpr uint64_t NO_KEY = UINT64_MAX;
+
+		private:
+			using KillerSlots = std::array<uint64_t, GADT_MINIMAX_KILLER_SLOTS>;
+
+			std::vector<KillerSlots> _killers;
+			std::vector<uint64_t> _history;
+
+		public:
+			MinimaxMoveOrdering() :
+				_killers(),
+				_history(GADT_MINIMAX_HISTORY_SIZE, 0)
+			{
+			}
+
+			//prepare for a new search, killer moves are removed and history is halved so that old bonus fades.
+			void init(size_t max_ply)
+			{
+				KillerSlots empty;
+				empty.fill(uint64_t(NO_KEY));	//prvalue, the member is not defined out of class.
+				_killers.assign(max_ply + 1, empty);
+				for (uint64_t& value : _history)
+					value /= 2;
+			}
+
+			//get the killer slot of the action key in the ply, return GADT_MINIMAX_KILLER_SLOTS if it is not a killer.
+			inline size_t killer_slot(size_t ply, uint64_t key) const
+			{
+				if (ply < _killers.size())
+					for (size_t i = 0; i < GADT_MINIMAX_KILLER_SLOTS; i++)
+						if (_killers[ply][i] == key)
+							return i;
+				return GADT_MINIMAX_KILLER_SLOTS;
+			}
+
+			//get history bonus of the action key.
+			inline uint64_t history(uint64_t key) const
+			{
+				return _history[key % GADT_MINIMAX_HISTORY_SIZE];
+			}
+
+			//record the action which caused beta cut.
+			void add_cut(size_t ply, uint64_t key, size_t depth)
+			{
+				if (ply < _killers.size() && _killers[ply][0] != key)
+				{
+					for (size_t i = GADT_MINIMAX_KILLER_SLOTS - 1; i > 0; i--)
+						_killers[ply][i] = _killers[ply][i - 1];
+					_killers[ply][0] = key;
+				}
+				_history[key % GADT_MINIMAX_HISTORY_SIZE] += depth * depth;
+			}
+
+			//remove all killer moves and history.
+			void clear()
+			{
+				for (KillerSlots& slots : _killers)
+					slots.fill(uint64_t(NO_KEY));
+				std::fill(_history.begin(), _history.end(), 0);
+			}
+		};
+
 		template<typename State, typename Action, typename EvalType, bool _is_debug>
 		struct MinimaxFuncPackage final: public GameAlgorithmFuncPackageBase<State, Action, _is_debug>
 		{
@@ -95,20 +379,38 @@ namespace gadt
 			using GameAlgorithmFuncPackageBase<State, Action, _is_debug>::DetermineWinnerFunc;
 #endif
 			using EvaluateStateFunc = std::function<EvalType(const State&, const AgentIndex)>;
+			using StateHashFunc = std::function<uint64_t(const State&)>;
+			using ActionKeyFunc = std::function<uint64_t(const Action&)>;
+			using ScoreActionFunc = std::function<double(const State&, const Action&)>;
+			using UndoStateFunc = std::function<void(State&, const Action&)>;
 
 		public:
 			//necessary functions.
 			const EvaluateStateFunc		EvaluateState;		//get the eval for parent node.
 
+			//optional functions.
+			const StateHashFunc			StateHash;			//hash of state, which is necessary for transposition table.
+			const ActionKeyFunc			ActionKey;			//key of action, which is necessary for killer moves and history heuristic.
+			const ScoreActionFunc		ScoreAction;		//cheap score of action, actions with higher score are searched first.
+			const UndoStateFunc			UndoState;			//revert the action applied by UpdateState, states are updated in place if it is set.
+
 		public:
 			MinimaxFuncPackage(
 				UpdateStateFunc			_UpdateState,
 				MakeActionFunc			_MakeAction,
 				DetermineWinnerFunc		_DetermineWinner,
-				EvaluateStateFunc		_EvaluateState
+				EvaluateStateFunc		_EvaluateState,
+				StateHashFunc			_StateHash = nullptr,
+				ActionKeyFunc			_ActionKey = nullptr,
+				ScoreActionFunc			_ScoreAction = nullptr,
+				UndoStateFunc			_UndoState = nullptr
 			) :
 				GameAlgorithmFuncPackageBase<State, Action, _is_debug>(_UpdateState, _MakeAction, _DetermineWinner),
-				EvaluateState(_EvaluateState)
+				EvaluateState(_EvaluateState),
+				StateHash(_StateHash),
+				ActionKey(_ActionKey),
+				ScoreAction(_ScoreAction),
+				UndoState(_UndoState)
 			{
 			}
 		};
@@ -116,6 +418,8 @@ namespace gadt
 		/*
 		* MinimaxNode is the node class in the minimax search.
 		*
+		* the state and action set of node are stored by the search, so that they can be reused by all the nodes of the same ply.
+		*
 		* [State] is the game-state class, which is defined by the user.
 		* [Action] is the game-action class, which is defined by the user.
 		* [is_debug] means some debug info would not be ignored if it is true. this may result in a little degradation of performance.
@@ -132,9 +436,9 @@ namespace gadt
 			using ActionList	= typename FuncPackage::ActionList;
 
 		private:
-			const State			  _state;		//game state
+			State&				  _state;		//game state
 			const size_t		  _depth;		//depth of the node
-			ActionList			  _action_list;	//action set
+			ActionList&			  _action_list;	//action set
 			AgentIndex			  _winner;		//winner of the node.
 
 		private:
@@ -143,20 +447,27 @@ namespace gadt
 			inline void NodeInit(const FuncPackage& func_package)
 			{
 				_winner = func_package.DetermineWinner(_state);
-				func_package.MakeAction(_state, _action_list);
 			}
 
 		public:
 			//constructor
-			MinimaxNode(const State& new_state, size_t depth, const FuncPackage& func_package):
-				_state(new_state),
+			MinimaxNode(State& state, size_t depth, ActionList& action_list, const FuncPackage& func_package):
+				_state(state),
 				_depth(depth),
-				_action_list(),
+				_action_list(action_list),
 				_winner()
 			{
+				_action_list.clear();
 				NodeInit(func_package);
 			}
 
+			//generate the action set of the node, which is delayed until the node is going to be expanded.
+			inline void MakeAction(const FuncPackage& func_package)
+			{
+				if (_action_list.size() == 0)
+					func_package.MakeAction(_state, _action_list);
+			}
+
 			//return the count of actions
 			inline size_t action_count() const
 			{
@@ -174,6 +485,12 @@ namespace gadt
 				return _state;
 			}
 
+			//get state of the node, which is updated in place if UndoState is set.
+			inline State& state()
+			{
+				return _state;
+			}
+
 			//get depth of current node.
 			inline size_t depth() const
 			{
@@ -202,6 +519,9 @@ namespace gadt
 		/*
 		* MinimaxSearch is a template of Minimax search.
 		*
+		* if thread_count in setting is more than 1, helper threads search the same root with a shared transposition table (lazy smp),
+		* and the result of main thread is returned. the functions in package should be thread safe in that case.
+		*
 		* [State] is the game-state class, which is defined by the user.
 		* [Action] is the game-action class, which is defined by the user.
 		* [_is_debug] decides whether debug info would be ignored or not. which may cause slight degradation in performance if it is enabled.
@@ -234,11 +554,76 @@ namespace gadt
 			using ActionList	= typename FuncPackage::ActionList;
 			using VisualTree	= visual_tree::VisualTree;
 			using VisualNodePtr	= visual_tree::VisualNode*;
+			using TranspositionTable = MinimaxTranspositionTable<EvalType>;
+
+		private:
+			//order of an action in a node.
+			struct ActionOrder
+			{
+				size_t		index;		//index of action in action list.
+				size_t		priority;	//hash move > killer moves > other actions.
+				double		score;		//score from ScoreAction.
+				uint64_t	history;	//history bonus.
+			};
+
+			//state of a searching thread, which is aligned to cache line to avoid false sharing between threads.
+			struct alignas(GADT_CACHE_LINE_SIZE) SearchContext
+			{
+				size_t		thread_id;			//0 is the main thread, others are helper threads of parallel search.
+				bool		allow_stop;			//the search can be stopped once an iteration is completed.
+				bool		stopped;			//the search is stopped, and all the results are discarded.
+				size_t		node_counter;		//count of visited nodes, which decides when to check the clock.
+				size_t		iteration_depth;	//depth of current iteration, which is used to get the ply of nodes.
+				MinimaxMoveOrdering	move_ordering;
+				std::vector<std::vector<ActionOrder>> action_orders;	//preallocated buffer of action orders for each ply.
+				std::vector<ActionList> pv_lines;	//principal variation from the node of each ply.
+				std::vector<State> states;			//preallocated state of each ply, only the first child ply is used if UndoState is set.
+				std::vector<ActionList> action_lists;	//preallocated action set of each ply.
+			};
 			
 		private:
 			
 			FuncPackage	_func_package;
 			Setting		_setting;
+			std::unique_ptr<TranspositionTable> _transposition_table;
+			timer::TimePoint _search_start;		//time point when the search started.
+			size_t		_completed_depth;		//depth of the deepest completed iteration.
+			std::vector<SearchContext, stl::AlignedAllocator<SearchContext>> _contexts;	//contexts of searching threads, aligned to cache line by the allocator.
+			std::atomic<bool> _stop_signal;		//main thread finished, helper threads should stop.
+			ActionList	_principal_variation;	//principal variation of the deepest completed iteration.
+
+		private:
+			//the lowest bound of search window, which is opposite to MAX_EVAL so that it can be negated without overflow.
+			static constexpr EvalType WindowMin()
+			{
+				return -static_cast<EvalType>(MAX_EVAL);
+			}
+
+			//get the upper bound of the null window above alpha.
+			static EvalType NullWindowBeta(EvalType alpha)
+			{
+				return NullWindowBeta(alpha, std::is_integral<EvalType>());
+			}
+
+			static EvalType NullWindowBeta(EvalType alpha, std::true_type)
+			{
+				return alpha + 1;
+			}
+
+			static EvalType NullWindowBeta(EvalType alpha, std::false_type)
+			{
+				return std::nextafter(alpha, static_cast<EvalType>(MAX_EVAL));
+			}
+
+			//save the principal variation of the ply, which is the action and the principal variation of its child.
+			static inline void UpdatePrincipalVariation(SearchContext& ctx, size_t ply, const Action& action)
+			{
+				ActionList& line = ctx.pv_lines[ply];
+				const ActionList& child_line = ctx.pv_lines[ply + 1];
+				line.clear();
+				line.push_back(action);
+				line.insert(line.end(), child_line.begin(), child_line.end());
+			}
 
 		private:
 			//convert minimax node to visual node.
@@ -250,13 +635,62 @@ namespace gadt
 				visual_node->add_value(MINIMAX_VT_IS_TERMINAL_STATE_NAME, node.is_terminal_state(setting));
 			}
 
+			//sort the actions of node into the order they are searched.
+			void OrderActions(const SearchContext& ctx, const Node& node, size_t ply, size_t hash_index, std::vector<ActionOrder>& orders)
+			{
+				const bool use_key = _setting.move_ordering && _func_package.ActionKey;
+				const bool use_score = _setting.move_ordering && _func_package.ScoreAction;
+				orders.resize(node.action_count());
+				for (size_t i = 0; i < node.action_count(); i++)
+				{
+					ActionOrder& order = orders[i];
+					order.index = i;
+					order.priority = 0;
+					order.score = use_score ? _func_package.ScoreAction(node.state(), node.action(i)) : 0;
+					order.history = 0;
+					if (i == hash_index)
+					{
+						order.priority = GADT_MINIMAX_KILLER_SLOTS + 1;
+					}
+					else if (use_key)
+					{
+						const uint64_t key = _func_package.ActionKey(node.action(i));
+						order.priority = GADT_MINIMAX_KILLER_SLOTS - ctx.move_ordering.killer_slot(ply, key);
+						order.history = ctx.move_ordering.history(key);
+					}
+				}
+				if (use_key || use_score)
+				{
+					std::stable_sort(orders.begin(), orders.end(), [](const ActionOrder& fir, const ActionOrder& sec)->bool {
+						if (fir.priority != sec.priority)
+							return fir.priority > sec.priority;
+						if (fir.score != sec.score)
+							return fir.score > sec.score;
+						return fir.history > sec.history;
+					});
+				}
+				else if (hash_index < orders.size())
+				{
+					std::rotate(orders.begin(), orders.begin() + hash_index, orders.begin() + hash_index + 1);
+				}
+			}
+
 			//get the highest eval for parent of node.
 			template<bool JSON_ENABLED, bool ALPHABETA_ENABLED>
-			EvalType NegamaxEvaluateStates(const Node& node, EvalType alpha, EvalType beta, VisualNodePtr parent_visual_node, size_t& leaf_node_count)
+			EvalType NegamaxEvaluateStates(SearchContext& ctx, Node& node, EvalType alpha, EvalType beta, VisualNodePtr parent_visual_node, size_t& leaf_node_count)
 			{
 				VisualNodePtr visual_node = nullptr;
 				const size_t original_leaf_node_count = leaf_node_count;
 
+				//check the clock and stop signal periodically, the result of a stopped search is meaningless.
+				if (ctx.allow_stop && (++ctx.node_counter & GADT_MINIMAX_TIMEOUT_CHECK_MASK) == 0)
+					if (timeout(_search_start, _setting.timeout) || (ctx.thread_id != 0 && _stop_signal.load(std::memory_order_relaxed)))
+						ctx.stopped = true;
+				if (ctx.stopped)
+					return alpha;
+				const size_t ply = ctx.iteration_depth - node.depth();
+				ctx.pv_lines[ply].clear();
+
 				if (JSON_ENABLED)
 				{
 					visual_node = parent_visual_node->create_child();
@@ -276,20 +710,89 @@ namespace gadt
 					return eval;
 				}
 
+				//probe transposition table before the actions are generated.
+				uint64_t hash = 0;
+				size_t hash_index = TranspositionTable::NO_INDEX;
+				if (_transposition_table)
+				{
+					hash = _func_package.StateHash(node.state());
+					typename TranspositionTable::Entry entry;
+					if (_transposition_table->probe(hash, entry))
+					{
+						if (entry.depth >= node.depth())
+						{
+							if (entry.bound == MinimaxBound::Exact ||
+								(entry.bound == MinimaxBound::Lower && entry.score >= beta) ||
+								(entry.bound == MinimaxBound::Upper && entry.score <= alpha))
+							{
+								EvalType eval = entry.score < alpha ? alpha : (entry.score > beta ? beta : entry.score);
+								if (JSON_ENABLED)
+								{
+									visual_node->add_value(MINIMAX_VT_EVALUATION_NAME, eval);
+								}
+								return eval;
+							}
+						}
+						hash_index = entry.best_index;
+					}
+				}
+
+				node.MakeAction(_func_package);
 				GADT_WARNING_IF(is_debug(), node.action_list().size() == 0, "MM101: empty action set");
+
+				//the best action in transposition table is searched first, then killer moves and others.
+				std::vector<ActionOrder>& orders = ctx.action_orders[ply];
+				OrderActions(ctx, node, ply, hash_index, orders);
 				
-				//pick up best value in child nodes.
+				//pick up best value in child nodes, the best value is the alpha of the following child nodes.
+				//the state of node is updated to child state and reverted after the child is searched if UndoState is set.
+				const bool in_place = static_cast<bool>(_func_package.UndoState);
 				EvalType best_value = alpha;
-				for (size_t i = 0; i < node.action_list().size(); i++)
+				size_t best_index = hash_index;
+				for (size_t n = 0; n < node.action_list().size(); n++)
 				{
-					State child_state = node.state();
+					const size_t i = orders[n].index;
+					State& child_state = in_place ? node.state() : ctx.states[ply + 1];
+					if (!in_place)
+						child_state = node.state();
 					_func_package.UpdateState(child_state, node.action_list()[i]);
-					Node child(child_state , node.depth() - 1, _func_package);
-					EvalType child_value = -NegamaxEvaluateStates<JSON_ENABLED, ALPHABETA_ENABLED>(child, -beta, -alpha, visual_node, leaf_node_count);
+					Node child(child_state, node.depth() - 1, ctx.action_lists[ply + 1], _func_package);
+					EvalType child_value;
+					if (ALPHABETA_ENABLED && _setting.principal_variation_search && n > 0)
+					{
+						//prove the child is not better than best value by null window, re-search it if it fails high.
+						child_value = -NegamaxEvaluateStates<JSON_ENABLED, ALPHABETA_ENABLED>(ctx, child, -NullWindowBeta(best_value), -best_value, visual_node, leaf_node_count);
+						if (child_value > best_value && child_value < beta && !ctx.stopped)
+							child_value = -NegamaxEvaluateStates<JSON_ENABLED, ALPHABETA_ENABLED>(ctx, child, -beta, -best_value, visual_node, leaf_node_count);
+					}
+					else
+					{
+						child_value = -NegamaxEvaluateStates<JSON_ENABLED, ALPHABETA_ENABLED>(ctx, child, -beta, ALPHABETA_ENABLED ? -best_value : -alpha, visual_node, leaf_node_count);
+					}
+					if (in_place)
+						_func_package.UndoState(child_state, node.action_list()[i]);
+					if (ctx.stopped)
+						return alpha;
 					if (ALPHABETA_ENABLED && child_value >= beta)
+					{
+						if (_transposition_table)
+							_transposition_table->store(hash, beta, node.depth(), MinimaxBound::Lower, i);
+						if (_setting.move_ordering && _func_package.ActionKey)
+							ctx.move_ordering.add_cut(ply, _func_package.ActionKey(node.action(i)), node.depth());
 						return beta;//prune!
+					}
+					if (child_value > best_value)
+					{
+						best_index = i;
+						UpdatePrincipalVariation(ctx, ply, node.action(i));
+					}
 					if (child_value >= best_value) { best_value = child_value; }
 				}
+				if (_transposition_table)
+				{
+					_transposition_table->store(hash, best_value, node.depth(),
+						best_value > alpha ? MinimaxBound::Exact : MinimaxBound::Upper, best_index);
+				}
 				if (JSON_ENABLED)
 				{
 					if (ALPHABETA_ENABLED)
@@ -303,12 +806,106 @@ namespace gadt
 				return best_value;
 			}
 
+			//search all the child nodes of root with appointed depth and window, return false if the search is stopped by timeout.
+			template<bool JSON_ENABLED, bool ALPHABETA_ENABLED>
+			bool SearchRootChildren(SearchContext& ctx, const Node& root, size_t depth, size_t first_index, EvalType alpha, EvalType beta, std::vector<EvalType>& eval_set, size_t& best_action_index, EvalType& best_value, VisualNodePtr root_visual_node, size_t& leaf_node_count)
+			{
+				ctx.iteration_depth = depth;
+				ctx.pv_lines[0].clear();
+				best_value = static_cast<EvalType>(MIN_EVAL);
+				best_action_index = first_index;
+				for (size_t n = 0; n < root.action_list().size(); n++)
+				{
+					//create new node, the best action of previous iteration is searched first.
+					const size_t i = n == 0 ? first_index : (n <= first_index ? n - 1 : n);
+					State& child_state = ctx.states[1];
+					child_state = root.state();
+					_func_package.UpdateState(child_state, root.action_list()[i]);
+					Node child(child_state, depth - 1, ctx.action_lists[1], _func_package);
+					const EvalType root_alpha = best_value > alpha ? best_value : alpha;
+					if (!ALPHABETA_ENABLED)
+					{
+						eval_set[i] = -NegamaxEvaluateStates<JSON_ENABLED, ALPHABETA_ENABLED>(ctx, child, WindowMin(), static_cast<EvalType>(MAX_EVAL), root_visual_node, leaf_node_count);
+					}
+					else if (_setting.principal_variation_search && n > 0)
+					{
+						eval_set[i] = -NegamaxEvaluateStates<JSON_ENABLED, ALPHABETA_ENABLED>(ctx, child, -NullWindowBeta(root_alpha), -root_alpha, root_visual_node, leaf_node_count);
+						if (eval_set[i] > root_alpha && eval_set[i] < beta && !ctx.stopped)
+							eval_set[i] = -NegamaxEvaluateStates<JSON_ENABLED, ALPHABETA_ENABLED>(ctx, child, -beta, -root_alpha, root_visual_node, leaf_node_count);
+					}
+					else
+					{
+						eval_set[i] = -NegamaxEvaluateStates<JSON_ENABLED, ALPHABETA_ENABLED>(ctx, child, -beta, -root_alpha, root_visual_node, leaf_node_count);
+					}
+					if (ctx.stopped)
+						return false;
+
+					if (eval_set[i] > best_value)
+					{
+						best_action_index = i;
+						best_value = eval_set[i];
+						UpdatePrincipalVariation(ctx, 0, root.action(i));
+					}
+					if (ALPHABETA_ENABLED && best_value >= beta)
+						break;
+				}
+				return true;
+			}
+
+			//search of helper thread, which runs iterative deepening with different root order and depth from main thread,
+			//so that the transposition table is filled by the results that main thread would need.
+			template<bool ALPHABETA_ENABLED>
+			void HelperSearch(SearchContext& ctx, const Node& root)
+			{
+				std::vector<EvalType> eval_set(root.action_count(), EvalType());
+				size_t best_action_index = ctx.thread_id % root.action_count();
+				EvalType best_value;
+				size_t leaf_node_count = 0;
+				const size_t max_depth = _setting.max_depth > 0 ? _setting.max_depth : 1;
+				for (size_t depth = 1 + ctx.thread_id % 2; depth <= max_depth && !_stop_signal.load(std::memory_order_relaxed); depth++)
+				{
+					if (!SearchRootChildren<false, ALPHABETA_ENABLED>(ctx, root, depth, best_action_index, WindowMin(), static_cast<EvalType>(MAX_EVAL), eval_set, best_action_index, best_value, nullptr, leaf_node_count))
+						break;
+				}
+			}
+
+			//reset the contexts of threads for a new search.
+			void PrepareContexts(size_t thread_count, const State& state)
+			{
+				_contexts.resize(thread_count);
+				for (size_t i = 0; i < thread_count; i++)
+				{
+					SearchContext& ctx = _contexts[i];
+					ctx.thread_id = i;
+					ctx.allow_stop = i != 0;
+					ctx.stopped = false;
+					ctx.node_counter = 0;
+					ctx.iteration_depth = 0;
+					ctx.move_ordering.init(_setting.max_depth);
+					ctx.action_orders.resize(_setting.max_depth + 1);
+					ctx.pv_lines.resize(_setting.max_depth + 2);
+					ctx.states.assign(_setting.max_depth + 2, state);
+					ctx.action_lists.resize(_setting.max_depth + 2);
+				}
+				_stop_signal = false;
+			}
+
 			//start a negamax search.
 			template<bool JSON_ENABLED, bool ALPHABETA_ENABLED, bool RETURN_WHEN_SINGLE_MOVE>
 			std::pair<Action, EvalType> StartNegamaxIteration(const State& state, Setting setting)
 			{
 				_setting = setting;
-				Node root(state, _setting.max_depth, _func_package);
+				_search_start.reset();
+				_completed_depth = 0;
+				_principal_variation.clear();
+				const size_t thread_count = _setting.thread_count > 0 ? _setting.thread_count : 1;
+				PrepareContexts(thread_count, state);
+				PrepareTranspositionTable();
+				GADT_WARNING_IF(is_debug(), thread_count > 1 && !_transposition_table, "MM104: parallel search without transposition table would not be faster.");
+				State root_state = state;
+				ActionList root_action_list;
+				Node root(root_state, _setting.max_depth, root_action_list, _func_package);
+				root.MakeAction(_func_package);
 				VisualNodePtr root_visual_node = nullptr;
 
 				GADT_WARNING_IF(is_debug(), root.is_terminal_state(_setting), "MM102: execute search for terminal state.");
@@ -327,6 +924,7 @@ namespace gadt
 					{
 						logger() << ">> Only one action is available. action = " << _log_controller.action_to_str_func()(root.action(0)) << std::endl;
 					}
+					_principal_variation.push_back(root.action(0));
 					return { root.action(0) , EvalType() };
 				}
 
@@ -336,23 +934,82 @@ namespace gadt
 				}
 				std::vector<EvalType> eval_set(root.action_list().size(), EvalType());
 				size_t leaf_node_count = 0;
-
 				EvalType best_value = static_cast<EvalType>(MIN_EVAL);
 				size_t best_action_index = 0;
-				for (size_t i = 0; i < root.action_list().size(); i++)
-				{
-					//create new node.
-					State child_state = state;
-					_func_package.UpdateState(child_state, root.action_list()[i]);
-					Node child(child_state, root.depth() - 1, _func_package);
-					EvalType child_beta = (ALPHABETA_ENABLED ? -best_value : static_cast<EvalType>(MAX_EVAL));
-					eval_set[i] = -NegamaxEvaluateStates<JSON_ENABLED, ALPHABETA_ENABLED>(child, static_cast<EvalType>(MIN_EVAL), child_beta , root_visual_node, leaf_node_count);
 
-					if (eval_set[i] > best_value)
+				//search depth 1, 2, 3... until max depth or timeout if iterative deepening is enabled.
+				//the main thread stops helper threads when it finished.
+				SearchContext& main_ctx = _contexts[0];
+				auto main_search = [&]()->void {
+					const size_t max_depth = _setting.max_depth > 0 ? _setting.max_depth : 1;
+					const size_t first_depth = _setting.iterative_deepening ? 1 : max_depth;
+					std::vector<EvalType> iteration_eval_set(eval_set.size(), EvalType());
+					for (size_t depth = first_depth; depth <= max_depth; depth++)
 					{
-						best_action_index = i;
-						best_value = eval_set[i];
+						if (JSON_ENABLED && depth > first_depth)
+						{
+							_log_controller.ClearVisualTree();
+							root_visual_node = _log_controller.visual_tree().root_node();
+						}
+						//search with aspiration window around the eval of previous iteration, and re-search with full window if it fails.
+						EvalType alpha = WindowMin();
+						EvalType beta = static_cast<EvalType>(MAX_EVAL);
+						const EvalType delta = static_cast<EvalType>(_setting.aspiration_window);
+						if (ALPHABETA_ENABLED && delta > 0 && _completed_depth > 0)
+						{
+							alpha = best_value > WindowMin() + delta ? best_value - delta : WindowMin();
+							beta = best_value < static_cast<EvalType>(MAX_EVAL) - delta ? best_value + delta : static_cast<EvalType>(MAX_EVAL);
+						}
+						size_t iteration_best_index = 0;
+						EvalType iteration_best_value;
+						bool completed = SearchRootChildren<JSON_ENABLED, ALPHABETA_ENABLED>(main_ctx, root, depth, best_action_index, alpha, beta, iteration_eval_set, iteration_best_index, iteration_best_value, root_visual_node, leaf_node_count);
+						if (completed && ((iteration_best_value <= alpha && alpha > WindowMin()) || (iteration_best_value >= beta && beta < static_cast<EvalType>(MAX_EVAL))))
+						{
+							completed = SearchRootChildren<JSON_ENABLED, ALPHABETA_ENABLED>(main_ctx, root, depth, best_action_index, WindowMin(), static_cast<EvalType>(MAX_EVAL), iteration_eval_set, iteration_best_index, iteration_best_value, root_visual_node, leaf_node_count);
+						}
+						if (!completed)
+						{
+							break;
+						}
+
+						//iteration is completed.
+						eval_set = iteration_eval_set;
+						best_action_index = iteration_best_index;
+						best_value = iteration_best_value;
+						_completed_depth = depth;
+						_principal_variation = main_ctx.pv_lines[0];
+						main_ctx.allow_stop = _setting.iterative_deepening;
+						if (_transposition_table)
+						{
+							_transposition_table->store(_func_package.StateHash(state), best_value, depth, MinimaxBound::Exact, best_action_index);
+						}
+						if (log_enabled() && _setting.iterative_deepening)
+						{
+							logger() << ">> depth = " << depth
+								<< ", best action = " << _log_controller.action_to_str_func()(root.action(best_action_index))
+								<< ", eval = " << ToString(best_value)
+								<< ", time = " << _search_start.time_since_created() << "s" << std::endl;
+						}
+						if (timeout(_search_start, _setting.timeout))
+						{
+							break;
+						}
 					}
+					_stop_signal = true;
+				};
+				if (thread_count == 1)
+				{
+					main_search();
+				}
+				else
+				{
+					thread::SharedPool().reserve(thread_count - 1);
+					thread::SharedPool().ParallelFor(thread_count, [&](size_t id)->void {
+						if (id == 0)
+							main_search();
+						else
+							HelperSearch<ALPHABETA_ENABLED>(_contexts[id], root);
+					});
 				}
 
 				if (log_enabled())
@@ -384,18 +1041,61 @@ namespace gadt
 				return { root.action_list()[best_action_index], best_value };
 			}
 
+			//create transposition table if it is enabled by setting, entries are kept between searches.
+			void PrepareTranspositionTable()
+			{
+				if (_setting.transposition_table_size == 0 || !_func_package.StateHash)
+				{
+					GADT_WARNING_IF(is_debug(), _setting.transposition_table_size > 0, "MM103: transposition table is disabled because StateHash is not set.");
+					_transposition_table.reset();
+				}
+				else if (!_transposition_table || _transposition_table->size() != TranspositionTable::ActualSize(_setting.transposition_table_size))
+				{
+					_transposition_table.reset(new TranspositionTable(_setting.transposition_table_size));
+				}
+			}
+
 		public:
 			//constructor func.
 			MinimaxSearch(
 				typename FuncPackage::UpdateStateFunc		UpdateState,
 				typename FuncPackage::MakeActionFunc		MakeAction,
 				typename FuncPackage::DetermineWinnerFunc	DetermineWinner,
-				typename FuncPackage::EvaluateStateFunc		EvaluateState
+				typename FuncPackage::EvaluateStateFunc		EvaluateState,
+				typename FuncPackage::StateHashFunc			StateHash = nullptr,
+				typename FuncPackage::ActionKeyFunc			ActionKey = nullptr,
+				typename FuncPackage::ScoreActionFunc		ScoreAction = nullptr,
+				typename FuncPackage::UndoStateFunc			UndoState = nullptr
 			):
 				GameAlgorithmBase<State, Action, AgentIndex, _is_debug>("Minimax"),
-				_func_package(UpdateState,MakeAction,DetermineWinner,EvaluateState),
-				_setting()
+				_func_package(UpdateState,MakeAction,DetermineWinner,EvaluateState,StateHash,ActionKey,ScoreAction,UndoState),
+				_setting(),
+				_transposition_table(),
+				_search_start(),
+				_completed_depth(0),
+				_contexts(),
+				_stop_signal(false),
+				_principal_variation()
+			{
+			}
+
+			//get the principal variation of last search, which is the expected actions of both sides from the root.
+			inline const ActionList& principal_variation() const
 			{
+				return _principal_variation;
+			}
+
+			//get the depth of the deepest completed iteration in last search.
+			inline size_t completed_depth() const
+			{
+				return _completed_depth;
+			}
+
+			//remove all entries in transposition table.
+			void ClearTranspositionTable()
+			{
+				if (_transposition_table)
+					_transposition_table->clear();
 			}
 
 			//excute nega minimax search
@@ -422,18 +1122,5 @@ namespace gadt
 				return StartNegamaxIteration<false, true, false>(state, setting).second;
 			}
 		};
-
-		/*
-		* ExpectimaxSearch is a template of Expectimax search.
-		*
-		* [State] is the game-state class, which is defined by the user.
-		* [Action] is the game-action class, which is defined by the user.
-		* [_is_debug] means some debug info would not be ignored if it is true. this may result in a little degradation of performance.
-		*/
-		template<typename State, typename Action, bool _is_debug = false>
-		class ExpectimaxSearch
-		{
-			//TODO
-		};
 	}
 }
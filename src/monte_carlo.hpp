@@ -22,6 +22,7 @@
 #include "gadtlib.h"
 #include "gadt_algorithm.hpp"
 #include "gadt_table.h"
+#include "gadt_thread.hpp"
 
 #pragma once
 
@@ -29,6 +30,28 @@ namespace gadt
 {
 	namespace monte_carlo
 	{
+		/*
+		* MonteCarloBudgetPolicy decides how a fixed budget of simulations is allocated to the actions of root node.
+		*
+		* None: simulations are allocated by action policy or uniformly, which is decided by enable_action_policy.
+		* SequentialHalving: the budget is split evenly into ceil(log2(K)) rounds, each round samples the remaining
+		*                    actions evenly and rejects the worse half of them.
+		* SuccessiveRejects: the budget is split into K - 1 phases, each phase samples the remaining actions evenly
+		*                    and rejects the worst one. the phases become longer as less actions remain.
+		*
+		* the budget is thread_count * simulation_times, and the last remaining action is selected. they minimize the 
+		* simple regret, which is the loss of the selected action, instead of the cumulative regret minimized by UCB.
+		*/
+		enum class MonteCarloBudgetPolicy : uint8_t
+		{
+			None = 0,
+			SequentialHalving = 1,
+			SuccessiveRejects = 2
+		};
+
+		//reward accumulated by the simulations, a win is 1 and a loss is 0.
+		using MonteCarloReward = double;
+
 		/*
 		* MonteCarloSetting is the setting of Monte Carlo.
 		*
@@ -43,14 +66,23 @@ namespace gadt
 			bool		enable_action_policy;		//enable action policy(like Flat-UCB )
 			size_t		simulation_times;			//simulation_time;
 			size_t		simulation_warning_length;	//if the simulation length out of this value, it would throw a warning if is debug.
-			
+			size_t		simulation_cutoff_length;	//steps after which the simulation is truncated and evaluated by EvaluateRollout, 0 means the simulation is played to the end.
+			uint64_t	random_seed;				//seed of the random generator of each thread, 0 means the generators are seeded by entropy.
+			size_t		sync_interval;				//simulations between the publications of the statistic of each thread, 0 means the statistic is only published at the end.
+			MonteCarloBudgetPolicy budget_policy;	//allocation of the simulations to root actions, enable_action_policy is ignored if it is not None.
+
 
 			//default setting constructor.
 			MonteCarloSetting() :
 				GameAlgorithmSettingBase(30,0),
 				thread_count(1),
 				enable_action_policy(true),
-				simulation_warning_length(1000)
+				simulation_times(10000),
+				simulation_warning_length(1000),
+				simulation_cutoff_length(0),
+				random_seed(0),
+				sync_interval(64),
+				budget_policy(MonteCarloBudgetPolicy::None)
 			{
 			}
 
@@ -65,7 +97,12 @@ namespace gadt
 				GameAlgorithmSettingBase(_timeout, _no_winner_index),
 				thread_count(_thread_count),
 				enable_action_policy(_enable_action_policy),
-				simulation_warning_length(_simulation_warning_length)
+				simulation_times(10000),
+				simulation_warning_length(_simulation_warning_length),
+				simulation_cutoff_length(0),
+				random_seed(0),
+				sync_interval(64),
+				budget_policy(MonteCarloBudgetPolicy::None)
 			{
 			}
 
@@ -73,14 +110,19 @@ namespace gadt
 			void PrintInfo() const override
 			{
 				size_t index = 0;
-				console::Table tb(2, 5);
+				console::Table tb(2, 10);
 				tb.set_width({ 12,6 });
 				tb.enable_title({ "MONTE CARLO SETTING" });
 				tb.set_cell_in_row(index++, { { "timeout" },{ ToString(timeout) } });
 				tb.set_cell_in_row(index++, { { "thread_count" },{ ToString(thread_count) } });
 				tb.set_cell_in_row(index++, { { "enable_action_policy" },{ ToString(enable_action_policy) } });
+				tb.set_cell_in_row(index++, { { "simulation_times" },{ ToString(simulation_times) } });
 				tb.set_cell_in_row(index++, { { "no_winner_index" },{ ToString(no_winner_index) } });
 				tb.set_cell_in_row(index++, { { "simulation_warning_length" },{ ToString(simulation_warning_length) } });
+				tb.set_cell_in_row(index++, { { "simulation_cutoff_length" },{ ToString(simulation_cutoff_length) } });
+				tb.set_cell_in_row(index++, { { "random_seed" },{ ToString(random_seed) } });
+				tb.set_cell_in_row(index++, { { "sync_interval" },{ ToString(sync_interval) } });
+				tb.set_cell_in_row(index++, { { "budget_policy" },{ ToString(static_cast<int>(budget_policy)) } });
 				tb.Print();
 			}
 		};
@@ -119,13 +161,13 @@ namespace gadt
 			const State		_state;				//state of this node.
 			AgentIndex		_winner_index;		//the winner index of the state.
 			uint32_t		_visited_time;		//how many times that this node had been visited.
-			uint32_t		_win_time;			//win time accmulated by the simulation.
+			MonteCarloReward	_win_time;		//reward accmulated by the simulation, which is the win time if the rewards are 0 or 1.
 
 		public:
 			const State&        state()               const { return _state; }
 			AgentIndex          winner_index()        const { return _winner_index; }
 			uint32_t            visited_time()        const { return _visited_time; }
-			uint32_t            win_time()            const { return _win_time; }
+			MonteCarloReward    win_time()            const { return _win_time; }
 
 			//increase visited time.
 			inline void incr_visited_time()
@@ -133,11 +175,17 @@ namespace gadt
 				_visited_time++;
 			}
 
-			//increase win time.
-			inline void incr_win_time()
+			//increase win reward.
+			inline void incr_win_time(MonteCarloReward reward = 1)
 			{
-				volatile uint32_t temp = _win_time + 1;
-				_win_time = temp;
+				_win_time += reward;
+			}
+
+			//set the statistic of this node.
+			inline void set_statistic(uint32_t visited_time, MonteCarloReward win_time)
+			{
+				_visited_time = visited_time;
+				_win_time = win_time;
 			}
 
 			//return true if the state is the terminal-state of the game.
@@ -191,6 +239,7 @@ namespace gadt
 			using ActionPolicyFunc		= std::function<UcbValue(const Node&, const Node&)>;
 			using DefaultPolicyFunc		= std::function<const Action&(const ActionList&)>;
 			using ValueForRootNodeFunc	= std::function<UcbValue(const Node&, const Node&)>;
+			using EvaluateRolloutFunc	= std::function<double(const State&, const State&)>;
 
 		public:
 			const StateToResultFunc		StateToResult;		//get a result from state and winner.
@@ -198,6 +247,7 @@ namespace gadt
 			ActionPolicyFunc			ActionPolicy;		//action policy is used for root node to select next action for simulation.
 			DefaultPolicyFunc			DefaultPolicy;		//the default policy to select action in simulation.
 			ValueForRootNodeFunc		ValueForRootNode;	//select best action of root node after iterations finished.
+			EvaluateRolloutFunc			EvaluateRollout;	//reward in [0, 1] of the player who acts in the state if the simulation is truncated at the second state.
 
 		public:
 			MonteCarloFuncPackage(
@@ -216,11 +266,14 @@ namespace gadt
 				}),
 				DefaultPolicy([](const ActionList& actions)->const Action&{
 					GADT_WARNING_IF(_is_debug, actions.size() == 0, "MCTS104: empty action set during default policy.");
-					return actions[rand() % actions.size()];
+					return actions[random::Bounded(actions.size())];
 				}),
 				ValueForRootNode([](const Node& parent, const Node& child)->UcbValue {
 					UcbValue avg = static_cast<UcbValue>(child.win_time()) / static_cast<UcbValue>(child.visited_time());
 					return policy::UCB1(avg, static_cast<UcbValue>(parent.visited_time()), static_cast<UcbValue>(child.visited_time()));
+				}),
+				EvaluateRollout([](const State&, const State&)->double {
+					return 0.5;
 				})
 			{
 			}
@@ -228,6 +281,82 @@ namespace gadt
 
 		};
 
+		/*
+		* MonteCarloThreadStatistic is the statistic of the nodes owned by a thread of Monte Carlo simulation.
+		*
+		* each thread selects and updates its own copy of the nodes, the statistic of the copies is the published statistic 
+		* of all threads plus the unpublished statistic of this thread. the unpublished counts are padded by a cache line 
+		* at both ends, so that the counters updated by different threads never share a cache line.
+		*/
+		template<typename State, typename Action, typename Result, bool _is_debug>
+		class MonteCarloThreadStatistic
+		{
+		public:
+			using Node = MonteCarloNode<State, Action, Result, _is_debug>;
+			using NodeList = std::vector<Node>;
+			using PublishedList = std::vector<std::atomic<uint32_t>>;				//visit counts of child nodes, the last one is root node.
+			using PublishedRewardList = std::vector<std::atomic<MonteCarloReward>>;	//win rewards of child nodes, the last one is root node.
+
+		private:
+			static constexpr size_t VISIT_PADDING = GADT_CACHE_LINE_SIZE / sizeof(uint32_t);
+			static constexpr size_t WIN_PADDING = GADT_CACHE_LINE_SIZE / sizeof(MonteCarloReward);
+
+			Node							_root;
+			NodeList						_child_nodes;
+			std::vector<uint32_t>			_unpublished_visit;		//[padding][visit of nodes][padding], the last node is root node.
+			std::vector<MonteCarloReward>	_unpublished_win;		//[padding][win of nodes][padding], the last node is root node.
+
+			inline uint32_t& unpublished_visit(size_t index) { return _unpublished_visit[VISIT_PADDING + index]; }
+			inline MonteCarloReward& unpublished_win(size_t index) { return _unpublished_win[WIN_PADDING + index]; }
+
+		public:
+			MonteCarloThreadStatistic(const Node& root, const NodeList& child_nodes) :
+				_root(root),
+				_child_nodes(child_nodes),
+				_unpublished_visit(child_nodes.size() + 1 + 2 * VISIT_PADDING, 0),
+				_unpublished_win(child_nodes.size() + 1 + 2 * WIN_PADDING, 0)
+			{
+			}
+
+			inline Node& root() { return _root; }
+			inline NodeList& child_nodes() { return _child_nodes; }
+
+			//update the statistic of root node and child node by a simulation.
+			inline void update(size_t index, MonteCarloReward reward)
+			{
+				_root.incr_visited_time();
+				_child_nodes[index].incr_visited_time();
+				unpublished_visit(index)++;
+				unpublished_visit(_child_nodes.size())++;
+				if (reward != 0)
+				{
+					_root.incr_win_time(reward);
+					_child_nodes[index].incr_win_time(reward);
+					unpublished_win(index) += reward;
+					unpublished_win(_child_nodes.size()) += reward;
+				}
+			}
+
+			//add the unpublished statistic to the published statistic, and get the statistic published by other threads.
+			//atomic floating point has no fetch_add before C++20, so the reward is added by compare and exchange.
+			void publish(PublishedList& visit, PublishedRewardList& win)
+			{
+				for (size_t i = 0; i <= _child_nodes.size(); i++)
+				{
+					uint32_t visit_count = visit[i].fetch_add(unpublished_visit(i), std::memory_order_relaxed) + unpublished_visit(i);
+					MonteCarloReward win_count = win[i].load(std::memory_order_relaxed);
+					while (!win[i].compare_exchange_weak(win_count, win_count + unpublished_win(i), std::memory_order_relaxed))
+					{
+					}
+					win_count += unpublished_win(i);
+					unpublished_visit(i) = 0;
+					unpublished_win(i) = 0;
+					Node& node = i < _child_nodes.size() ? _child_nodes[i] : _root;
+					node.set_statistic(visit_count, win_count);
+				}
+			}
+		};
+
 		template<typename State, typename Action, typename Result, bool _is_debug>
 		class MonteCarloSimulation final :public GameAlgorithmBase<State, Action, Result, _is_debug>
 		{
@@ -254,15 +383,20 @@ namespace gadt
 			using ActionList = typename FuncPackage::ActionList;
 			using NodeList = std::vector<Node>;
 			using CountList = std::vector<size_t>;
+			using ThreadStatistic = MonteCarloThreadStatistic<State, Action, Result, _is_debug>;
+			using PublishedList = typename ThreadStatistic::PublishedList;
+			using PublishedRewardList = typename ThreadStatistic::PublishedRewardList;
 
 		private:
 			FuncPackage _func_package;
 			MonteCarloSetting _setting;
+			size_t _simulation_count;		//count of simulations in last run.
 
 		private:
 			
-			//simulation.
-			Result Simulation(const State& original_state) const
+			//simulation, return the reward of the player who acts in root state, which is 1 for a win and 0 otherwise.
+			//the simulation is truncated after simulation_cutoff_length steps if it is not 0, and the reward is evaluated by EvaluateRollout.
+			MonteCarloReward Simulation(const State& root_state, const State& original_state) const
 			{
 				State state = original_state;	//copy
 				ActionList actions;
@@ -276,7 +410,13 @@ namespace gadt
 					//return result if exist.
 					if (winner != _setting.no_winner_index)
 					{
-						return _func_package.StateToResult(state, winner);
+						return _func_package.AllowUpdateValue(root_state, _func_package.StateToResult(state, winner)) ? 1 : 0;
+					}
+
+					//evaluate the state if the simulation is truncated.
+					if (_setting.simulation_cutoff_length > 0 && i >= _setting.simulation_cutoff_length)
+					{
+						return _func_package.EvaluateRollout(root_state, state);
 					}
 
 					//generate new actions.
@@ -290,27 +430,25 @@ namespace gadt
 					//state update.
 					_func_package.UpdateState(state, action);
 				}
-				return _func_package.StateToResult(state, _setting.no_winner_index);
+				return 0;
 			}
 
-			//execute simulation.
-			void ExecuteSimulation(Node& parent, Node& child) const
+			//execute simulation for the child node of the thread.
+			void ExecuteSimulation(ThreadStatistic& statistic, size_t index) const
 			{
-				Result result = child.is_end_state(_setting)
-					? _func_package.StateToResult(child.state(),child.winner_index())
-					: Simulation(child.state());
-				child.incr_visited_time();
-				parent.incr_visited_time();
-				if (_func_package.AllowUpdateValue(parent.state(), result))
-				{
-					child.incr_win_time();
-					parent.incr_win_time();
-				}
+				const Node& child = statistic.child_nodes()[index];
+				const State& root_state = statistic.root().state();
+				MonteCarloReward reward = child.is_end_state(_setting)
+					? (_func_package.AllowUpdateValue(root_state, _func_package.StateToResult(child.state(), child.winner_index())) ? 1 : 0)
+					: Simulation(root_state, child.state());
+				statistic.update(index, reward);
 			}
 
 			//select best child by action policy.
-			void Selection(Node& parent, NodeList& child_nodes) const
+			void Selection(ThreadStatistic& statistic) const
 			{
+				const Node& parent = statistic.root();
+				const NodeList& child_nodes = statistic.child_nodes();
 				size_t best_index = 0;
 				UcbValue best_value = _func_package.ActionPolicy(parent, child_nodes[0]);
 				for (size_t i = 1; i < child_nodes.size(); i++)
@@ -324,20 +462,129 @@ namespace gadt
 				}
 
 				//execute simulation in best child
-				ExecuteSimulation(parent, child_nodes[best_index]);
+				ExecuteSimulation(statistic, best_index);
 			}
 
 			//execute simulatio for all child nodes.
-			void ExecuteAllChild(Node& parent, NodeList& child_nodes) const
+			void ExecuteAllChild(ThreadStatistic& statistic) const
+			{
+				for (size_t i = 0; i < statistic.child_nodes().size(); i++)
+				{
+					ExecuteSimulation(statistic, i);
+				}
+			}
+
+			//execute simulations of a thread, the statistic is published every sync interval and at the end.
+			void ExecuteThread(ThreadStatistic& statistic, PublishedList& published_visit, PublishedRewardList& published_win, const timer::TimePoint& tp_mc_start) const
+			{
+				const size_t sim_time = _setting.enable_action_policy
+					? 1 + _setting.simulation_times
+					: 1 + (_setting.simulation_times / statistic.child_nodes().size());
+				for (size_t i = 0; i < sim_time; i++)
+				{
+					if (this->timeout(tp_mc_start, _setting.timeout))
+						break;
+					if (_setting.enable_action_policy)
+						Selection(statistic);
+					else
+						ExecuteAllChild(statistic);
+					if (_setting.sync_interval > 0 && (i + 1) % _setting.sync_interval == 0)
+						statistic.publish(published_visit, published_win);
+				}
+				statistic.publish(published_visit, published_win);
+			}
+
+			//get the action with the highest average reward in the published statistic.
+			static bool HigherAverage(const PublishedList& visit, const PublishedRewardList& win, size_t fir, size_t sec)
+			{
+				const double fir_avg = static_cast<double>(win[fir].load(std::memory_order_relaxed)) / static_cast<double>(visit[fir].load(std::memory_order_relaxed));
+				const double sec_avg = static_cast<double>(win[sec].load(std::memory_order_relaxed)) / static_cast<double>(visit[sec].load(std::memory_order_relaxed));
+				return fir_avg > sec_avg;
+			}
+
+			//execute the simulations of the remaining actions by all threads, each action is simulated for the given times.
+			//return false if the search is stopped by timeout.
+			bool ExecuteBudgetPhase(std::vector<std::unique_ptr<ThreadStatistic>>& statistics, const Node& root, const NodeList& child_nodes, const std::vector<size_t>& remaining, 
+				size_t times, size_t phase, PublishedList& published_visit, PublishedRewardList& published_win, const timer::TimePoint& tp_mc_start)
+			{
+				const size_t thread_count = statistics.size();
+				thread::SharedPool().ParallelFor(thread_count, [&](size_t id)->void {
+					if (_setting.random_seed != 0)
+						random::SeedThread(random::DeriveSeed(_setting.random_seed, phase * thread_count + id));
+					if (!statistics[id])
+						statistics[id].reset(new ThreadStatistic(root, child_nodes));
+					const size_t thread_times = times / thread_count + (id < times % thread_count ? 1 : 0);
+					for (size_t index : remaining)
+					{
+						for (size_t i = 0; i < thread_times; i++)
+						{
+							if (this->timeout(tp_mc_start, _setting.timeout))
+								break;
+							ExecuteSimulation(*statistics[id], index);
+						}
+					}
+					statistics[id]->publish(published_visit, published_win);
+				});
+				return !this->timeout(tp_mc_start, _setting.timeout);
+			}
+
+			//allocate the budget of simulations by the budget policy, return the index of the selected action.
+			size_t ExecuteBudget(const Node& root, const NodeList& child_nodes, PublishedList& published_visit, PublishedRewardList& published_win, const timer::TimePoint& tp_mc_start)
 			{
-				for (Node& child : child_nodes)
+				const size_t action_count = child_nodes.size();
+				const size_t budget = _setting.thread_count * _setting.simulation_times;
+				std::vector<std::unique_ptr<ThreadStatistic>> statistics(_setting.thread_count);
+				std::vector<size_t> remaining(action_count);
+				for (size_t i = 0; i < action_count; i++)
+					remaining[i] = i;
+				auto sort_remaining = [&]()->void {
+					std::stable_sort(remaining.begin(), remaining.end(), [&](size_t fir, size_t sec)->bool {
+						return HigherAverage(published_visit, published_win, fir, sec);
+					});
+				};
+
+				if (_setting.budget_policy == MonteCarloBudgetPolicy::SequentialHalving)
+				{
+					//each round samples the remaining actions evenly, and the better half of them remains.
+					size_t rounds = 0;
+					for (size_t count = 1; count < action_count; count *= 2)
+						rounds++;
+					for (size_t phase = 0; remaining.size() > 1; phase++)
+					{
+						const size_t times = std::max<size_t>(1, budget / (remaining.size() * rounds));
+						const bool finished = ExecuteBudgetPhase(statistics, root, child_nodes, remaining, times, phase, published_visit, published_win, tp_mc_start);
+						sort_remaining();
+						if (!finished)
+							break;
+						remaining.resize((remaining.size() + 1) / 2);
+					}
+				}
+				else
 				{
-					ExecuteSimulation(parent, child);
+					//phase k samples the remaining actions until each of them is simulated for n_k times, then the worst one is rejected.
+					//n_k = ceil((budget - K) / (log_bar(K) * (K + 1 - k))), log_bar(K) = 1/2 + 1/2 + 1/3 + ... + 1/K.
+					double log_bar = 0.5;
+					for (size_t i = 2; i <= action_count; i++)
+						log_bar += 1.0 / static_cast<double>(i);
+					const double rest_budget = budget > action_count ? static_cast<double>(budget - action_count) : 0;
+					size_t last_times = 0;
+					for (size_t phase = 1; remaining.size() > 1; phase++)
+					{
+						const size_t phase_times = std::max<size_t>(1, static_cast<size_t>(std::ceil(rest_budget / (log_bar * static_cast<double>(action_count + 1 - phase)))));
+						const size_t times = phase_times > last_times ? phase_times - last_times : 0;
+						last_times = std::max(last_times, phase_times);
+						const bool finished = times == 0 || ExecuteBudgetPhase(statistics, root, child_nodes, remaining, times, phase, published_visit, published_win, tp_mc_start);
+						sort_remaining();
+						if (!finished)
+							break;
+						remaining.pop_back();
+					}
 				}
+				return remaining.front();
 			}
 
 			//execute monte carlo.
-			Action ExecuteMonteCarlo(const State& state) const
+			Action ExecuteMonteCarlo(const State& state)
 			{
 				//get available actions
 				Node root(state, _func_package);
@@ -378,44 +625,52 @@ namespace gadt
 				}
 				
 
-				//create threads.
-				std::vector<std::thread> threads;
-				for (size_t thread_id = 0; thread_id < _setting.thread_count; thread_id++)
+				//statistic published by all threads, the last one is root node.
+				PublishedList published_visit(child_nodes.size() + 1);
+				PublishedRewardList published_win(child_nodes.size() + 1);
+				for (size_t i = 0; i <= child_nodes.size(); i++)
 				{
-					threads.push_back(std::thread([&]()->void {
-						if (_setting.enable_action_policy)
-						{
-							size_t sim_time = 1 + _setting.simulation_times;
-							for (size_t i = 0; i < sim_time; i++)
-							{
-								if (this->timeout(tp_mc_start, _setting.timeout)) { return; }
-								Selection(root, child_nodes);
-							}
-						}
-						else
-						{
-							size_t sim_time = 1 + (_setting.simulation_times / child_nodes.size());
-							for (size_t i = 0; i < sim_time; i++)
-							{
-								if (this->timeout(tp_mc_start, _setting.timeout)) { return; }
-								ExecuteAllChild(root, child_nodes);
-							}
-						}
-					}));
+					const Node& node = i < child_nodes.size() ? child_nodes[i] : root;
+					published_visit[i].store(node.visited_time(), std::memory_order_relaxed);
+					published_win[i].store(node.win_time(), std::memory_order_relaxed);
+				}
+
+				//excute simulations by the shared pool, the calling thread is also a worker.
+				//each thread creates its own statistic, so that the nodes updated by different threads are allocated separately.
+				if (_setting.thread_count > 1)
+					thread::SharedPool().reserve(_setting.thread_count - 1);
+				size_t budget_best_index = 0;
+				if (_setting.budget_policy != MonteCarloBudgetPolicy::None)
+				{
+					budget_best_index = ExecuteBudget(root, child_nodes, published_visit, published_win, tp_mc_start);
 				}
-				//join all threads.
-				for (size_t i = 0; i < threads.size(); i++)
+				else
 				{
-					threads[i].join();
+					thread::SharedPool().ParallelFor(_setting.thread_count, [&](size_t id)->void {
+						if (_setting.random_seed != 0)
+							random::SeedThread(random::DeriveSeed(_setting.random_seed, id));
+						ThreadStatistic statistic(root, child_nodes);
+						ExecuteThread(statistic, published_visit, published_win, tp_mc_start);
+					});
 				}
 
+				//all the statistic had been published.
+				for (size_t i = 0; i <= child_nodes.size(); i++)
+				{
+					Node& node = i < child_nodes.size() ? child_nodes[i] : root;
+					node.set_statistic(published_visit[i].load(std::memory_order_relaxed), published_win[i].load(std::memory_order_relaxed));
+				}
+				_simulation_count = root.visited_time() - 1;
+
 				//accumulate all the count list
 				std::vector<UcbValue> child_value_set(child_nodes.size(), 0);
 				for (size_t i = 0; i < child_nodes.size(); i++)
 				{
 					child_value_set[i] = _func_package.ValueForRootNode(root, child_nodes[i]);
 				}
-				size_t best_node_index = func::GetMaxElementIndex<UcbValue>(child_value_set);
+				size_t best_node_index = _setting.budget_policy != MonteCarloBudgetPolicy::None
+					? budget_best_index
+					: func::GetMaxElementIndex<UcbValue>(child_value_set);
 				
 				//output log.
 				if (log_enabled())
@@ -461,20 +716,29 @@ namespace gadt
 			):
 				GameAlgorithmBase<State, Action, Result, _is_debug>("Monte Carlo"),
 				_func_package(_UpdateState, _MakeAction, _DetermineWinner, _StateToResult, _AllowUpdateValue),
-				_setting()
+				_setting(),
+				_simulation_count(0)
 			{
 			}
 
 			MonteCarloSimulation(const FuncPackage& func_package) :
 				GameAlgorithmBase<State, Action, Result, _is_debug>("Monte Carlo"),
 				_func_package(func_package),
-				_setting()
+				_setting(),
+				_simulation_count(0)
+			{
+			}
+
+			//get the count of simulations in last run.
+			inline size_t simulation_count() const
 			{
+				return _simulation_count;
 			}
 
 			Action Run(const State state, MonteCarloSetting setting)
 			{
 				_setting = setting;
+				_simulation_count = 0;
 				return ExecuteMonteCarlo(state);
 			}
 		};
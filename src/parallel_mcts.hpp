@@ -29,6 +29,10 @@ namespace gadt
 	{
 		/*
 		* class LockFreeMCTS is a template of lock-free MCTS, which is a lock free and multi-thread(tree parallelization).
+		* all threads share one tree, so MctsNodeStorage::Compact is ignored and linked nodes are always used.
+		* statistics of nodes are atomic and child nodes are expanded by CAS, set MctsSetting::virtual_loss to keep 
+		* the threads away from the path that is being searched by other threads. MctsSetting::gc_policy is ignored.
+		* transposition table is not supported, MctsSetting::transposition_table_size is ignored with a warning.
 		*
 		* [State] is the game-state class, which is defined by the user.
 		* [Action] is the game-action class, which is defined by the user.
@@ -50,6 +54,7 @@ namespace gadt
 			using MctsBase<State, Action, Result, _is_debug>::_setting;
 			using MctsBase<State, Action, Result, _is_debug>::Set;
 			using MctsBase<State, Action, Result, _is_debug>::MctsIteration;
+			using MctsBase<State, Action, Result, _is_debug>::SeedRandom;
 			using MctsBase<State, Action, Result, _is_debug>::ExcuteIteration;
 			using MctsBase<State, Action, Result, _is_debug>::ExcuteMCTS;
 
@@ -64,23 +69,20 @@ namespace gadt
 			//excute mcts iterations.
 			void ExcuteIteration(Node& root_node, stl::LinearAllocator<Allocator, _is_debug>& allocators) override
 			{
-				//thread content
-				std::vector<std::thread> threads;
+				//the nodes would not compute state hash for the unsupported transposition table.
+				GADT_WARNING_IF(_is_debug, _setting.transposition_table_size > 0, "MCTS115: transposition table is not supported by this search.");
+				_setting.transposition_table_size = 0;
 
-				//enable multithread.
+				//allocator of each thread.
+				std::vector<Allocator*> thread_allocators;
 				for (size_t thread_id = 0; thread_id < _setting.max_thread; thread_id++)
-				{
-					Allocator* thread_allocator = allocators.construct(_setting.max_node_per_thread);
-					threads.push_back(std::thread([&](Allocator* allocator)->void {
-						MctsIteration(&root_node, allocator);
-					}, thread_allocator));
-				}
+					thread_allocators.push_back(allocators.construct(_setting.max_node_per_thread));
 
-				//join all threads.
-				for (size_t i = 0; i < threads.size(); i++)
-				{
-					threads[i].join();
-				}
+				//excute iterations by the shared pool.
+				thread::SharedPool().ParallelFor(_setting.max_thread, [&](size_t thread_id)->void {
+					SeedRandom(thread_id);
+					MctsIteration(&root_node, thread_allocators[thread_id], false);//the tree is shared, garbage collection is disabled.
+				});
 
 				//delete the original visit of root node.
 				root_node.set_visit_count(root_node.visit_count() - 1);
@@ -125,6 +127,13 @@ namespace gadt
 
 		/*
 		* class MultiTreeMCTS is a template of root parallelization MCTS, which is lock-free and multi-thread(root parallelization).
+		* if sync_interval in setting is not 0, the statistic of the nodes in top sync_depth levels is shared by all threads 
+		* every sync_interval iterations, so that all threads spend iterations on the promising actions. the nodes are matched
+		* by the indexes of actions. compact storage is never synchronized.
+		* after search, the trees of all threads are merged into one tree recursively, whose nodes are matched by actions, so
+		* Action must be comparable by operator==. if tree reuse is enabled, the merged tree is kept between runs and its root
+		* is advanced by AdvanceRoot, in the same way as MonteCarloTreeSearch. the reused tree is always stored by linked nodes.
+		* transposition table is not supported, MctsSetting::transposition_table_size is ignored with a warning.
 		*
 		* [State] is the game-state class, which is defined by the user.
 		* [Action] is the game-action class, which is defined by the user.
@@ -146,61 +155,224 @@ namespace gadt
 			using MctsBase<State, Action, Result, _is_debug>::_setting;
 			using MctsBase<State, Action, Result, _is_debug>::Set;
 			using MctsBase<State, Action, Result, _is_debug>::MctsIteration;
+			using MctsBase<State, Action, Result, _is_debug>::SeedRandom;
+			using MctsBase<State, Action, Result, _is_debug>::ThreadIteration;
+			using MctsBase<State, Action, Result, _is_debug>::ThreadAllocatorSize;
+			using MctsBase<State, Action, Result, _is_debug>::MergeTree;
 			using MctsBase<State, Action, Result, _is_debug>::ExcuteIteration;
 			using MctsBase<State, Action, Result, _is_debug>::ExcuteMCTS;
+			using MctsBase<State, Action, Result, _is_debug>::StartMCTS;
+			using MctsBase<State, Action, Result, _is_debug>::IsSingleActionRoot;
+			using MctsBase<State, Action, Result, _is_debug>::FinishMCTS;
+			using MctsBase<State, Action, Result, _is_debug>::PrepareTreeRoot;
+			using MctsBase<State, Action, Result, _is_debug>::EnableTreeReuse;
+			using MctsBase<State, Action, Result, _is_debug>::DisableTreeReuse;
+			using MctsBase<State, Action, Result, _is_debug>::ClearTree;
+			using MctsBase<State, Action, Result, _is_debug>::AdvanceRoot;
+			using MctsBase<State, Action, Result, _is_debug>::tree_root;
 
 		private:
 
 			using Node = MctsNode<State, Action, Result, _is_debug>;				//searcg node.	
 			using Allocator = typename Node::Allocator;								//allocator of nodes
 			using FuncPackage = MctsFuncPackage<State, Action, Result, _is_debug>;	//function package.
+			using NodeKey = std::vector<size_t>;									//indexes of actions from root node.
+
+			struct NodeStatistic
+			{
+				uint32_t visit_count;
+				MctsReward win_count;
+			};
+
+			using NodeStatisticMap = std::map<NodeKey, NodeStatistic>;
+
+			using MctsBase<State, Action, Result, _is_debug>::_tree_reuse;
+			using MctsBase<State, Action, Result, _is_debug>::_tree_allocator;
 
 		private:
 
-			//excute mcts iterations.
-			void ExcuteIteration(Node& root_node, stl::LinearAllocator<Allocator, _is_debug>& allocators) override
+			std::mutex										_sync_mutex;		//mutex of shared statistic.
+			std::map<NodeKey, std::vector<NodeStatistic>>	_shared_statistic;	//statistic of each thread in top levels.
+
+		private:
+
+			//get the nodes in top sync_depth levels with their keys.
+			void GetSyncNodes(Node* root_node, std::vector<std::pair<NodeKey, Node*>>& nodes) const
+			{
+				nodes.clear();
+				nodes.push_back({ NodeKey(), root_node });
+				for (size_t i = 0; i < nodes.size(); i++)
+				{
+					if (nodes[i].first.size() >= _setting.sync_depth)
+						continue;
+					Node* node = nodes[i].second;
+					for (size_t child = 0; child < node->child_count(); child++)
+					{
+						NodeKey key = nodes[i].first;
+						key.push_back(child);
+						nodes.push_back({ key, node->child_node(child) });
+					}
+				}
+			}
+
+			//publish the statistic of this thread and replace the statistic imported from other threads.
+			//nodes that are released by garbage collection lose the imported statistic.
+			void SyncStatistic(size_t thread_id, Node* root_node, NodeStatisticMap& imported)
 			{
-				//thread content
-				std::vector<std::thread> threads;
+				std::vector<std::pair<NodeKey, Node*>> nodes;
+				GetSyncNodes(root_node, nodes);
+				NodeStatisticMap next_imported;
+				std::lock_guard<std::mutex> lock(_sync_mutex);
+				for (const auto& pair : nodes)
+				{
+					Node* node = pair.second;
+					NodeStatistic old = { 0, 0 };
+					auto iter = imported.find(pair.first);
+					if (iter != imported.end())
+						old = iter->second;
+
+					//statistic of this thread.
+					NodeStatistic own = {
+						node->visit_count() - std::min(node->visit_count(), old.visit_count),
+						node->win_count() - std::min(node->win_count(), old.win_count)
+					};
+					std::vector<NodeStatistic>& thread_stats = _shared_statistic[pair.first];
+					thread_stats.resize(_setting.max_thread, { 0, 0 });
+					thread_stats[thread_id] = own;
+
+					//statistic of other threads.
+					NodeStatistic foreign = { 0, 0 };
+					for (size_t i = 0; i < thread_stats.size(); i++)
+					{
+						if (i != thread_id)
+						{
+							foreign.visit_count += thread_stats[i].visit_count;
+							foreign.win_count += thread_stats[i].win_count;
+						}
+					}
+					node->set_visit_count(own.visit_count + foreign.visit_count);
+					node->set_win_count(own.win_count + foreign.win_count);
+					next_imported[pair.first] = foreign;
+				}
+				imported.swap(next_imported);
+			}
+
+			//remove the statistic imported from other threads, so that the tree only includes the iterations of this thread.
+			void RemoveImportedStatistic(Node* root_node, const NodeStatisticMap& imported) const
+			{
+				std::vector<std::pair<NodeKey, Node*>> nodes;
+				GetSyncNodes(root_node, nodes);
+				for (const auto& pair : nodes)
+				{
+					auto iter = imported.find(pair.first);
+					if (iter == imported.end())
+						continue;
+					Node* node = pair.second;
+					node->set_visit_count(node->visit_count() - std::min(node->visit_count(), iter->second.visit_count));
+					node->set_win_count(node->win_count() - std::min(node->win_count(), iter->second.win_count));
+				}
+			}
+
+			//excute iterations of a thread, the statistic is synchronized every sync_interval iterations.
+			void SyncThreadIteration(size_t thread_id, Node* root_node, Allocator* allocator)
+			{
+				timer::TimePoint tp;
+				NodeStatisticMap imported;
+				for (size_t finished = 0; finished < _setting.max_iteration_per_thread; finished += _setting.sync_interval)
+				{
+					size_t iteration_time = std::min(_setting.sync_interval, _setting.max_iteration_per_thread - finished);
+					bool completed = MctsIteration(root_node, allocator, iteration_time, tp);
+					SyncStatistic(thread_id, root_node, imported);
+					if (!completed)
+						break;
+				}
+				RemoveImportedStatistic(root_node, imported);
+			}
+
+			//excute iterations of all threads and merge their trees into the tree of root node.
+			//if tree_allocator is given, root node belongs to the reused tree, which is also the allocator of merged nodes.
+			void ExcuteTrees(Node& root_node, Allocator* tree_allocator, stl::LinearAllocator<Allocator, _is_debug>& allocators)
+			{
+				//the nodes would not compute state hash for the unsupported transposition table.
+				GADT_WARNING_IF(_is_debug, _setting.transposition_table_size > 0, "MCTS115: transposition table is not supported by this search.");
+				_setting.transposition_table_size = 0;
+
+				_shared_statistic.clear();
+				const bool sync_enabled = _setting.sync_interval > 0 && _setting.node_storage == MctsNodeStorage::Linked;
 				stl::LinearAllocator<Node> root_node_copys(_setting.max_thread - 1);
 				for (size_t i = 1; i < _setting.max_thread; i++)
 					root_node_copys.construct(root_node.state(), nullptr, _func_package, _setting);//copy
 
-				//enable multithread.
+				//root node and allocator of each thread.
+				std::vector<Node*> thread_nodes;
+				std::vector<Allocator*> thread_allocators;
 				for (size_t thread_id = 0; thread_id < _setting.max_thread; thread_id++)
 				{
 					Node* thread_node = &root_node;
 					if (thread_id > 0)
 						thread_node = root_node_copys[thread_id - 1];
-
-					Allocator* thread_allocator = allocators.construct(_setting.max_node_per_thread);
-					threads.push_back(std::thread([&](Node* node, Allocator* allocator)->void {
-						MctsIteration(node, allocator);
-					},thread_node, thread_allocator));
+					thread_nodes.push_back(thread_node);
+					if (thread_id == 0 && tree_allocator != nullptr)
+						thread_allocators.push_back(tree_allocator);
+					else
+						thread_allocators.push_back(allocators.construct(ThreadAllocatorSize(*thread_node)));
 				}
 
-				//join all threads.
-				for (size_t i = 0; i < threads.size(); i++)
-				{
-					threads[i].join();
-				}
+				//excute iterations by the shared pool.
+				thread::SharedPool().ParallelFor(_setting.max_thread, [&](size_t thread_id)->void {
+					SeedRandom(thread_id);
+					if (sync_enabled)
+						SyncThreadIteration(thread_id, thread_nodes[thread_id], thread_allocators[thread_id]);
+					else
+						ThreadIteration(thread_nodes[thread_id], thread_allocators[thread_id]);
+				});
 
-				//accmulate values in all copys of root node.
-				for (size_t copy_index = 0; copy_index < root_node_copys.size(); copy_index++)
+				//merge the trees of all copys into the tree of root node, the nodes that only exist in copys are allocated 
+				//by the extra allocator, which is large enough to hold all the nodes of copys, or by the allocator of reused tree.
+				if (root_node_copys.size() > 0)
 				{
-					Node* copy = root_node_copys[copy_index];
-					root_node.set_visit_count(root_node.visit_count() + copy->visit_count());
-					std::vector<Node*> root_childs = root_node.child_ptr_set();
-					std::vector<Node*> copy_childs = copy->child_ptr_set();
-					for (size_t i = 0; i < root_childs.size() && i < copy_childs.size(); i++)
+					Allocator* merge_allocator = tree_allocator;
+					if (merge_allocator == nullptr)
+					{
+						size_t merge_size = 0;
+						for (size_t i = 1; i < thread_allocators.size(); i++)
+							merge_size += thread_allocators[i]->size();
+						merge_allocator = allocators.construct(merge_size > 0 ? merge_size : 1);
+					}
+					for (size_t copy_index = 0; copy_index < root_node_copys.size(); copy_index++)
 					{
-						root_childs[i]->set_visit_count(root_childs[i]->visit_count() + copy_childs[i]->visit_count());
-						root_childs[i]->set_win_count(root_childs[i]->win_count() + copy_childs[i]->win_count());
+						Node* copy = root_node_copys[copy_index];
+						MergeTree(&root_node, copy, merge_allocator);
+						copy->FreeChildNodes(*thread_allocators[copy_index + 1]);
 					}
 				}
 
-				//delete the original visit of root node and its copys.
-				root_node.set_visit_count(root_node.visit_count() - static_cast<uint32_t>(_setting.max_thread));
+				//delete the original visit of its copys and root node, the root of reused tree only counts the iterations.
+				const uint32_t original_visit = static_cast<uint32_t>(root_node_copys.size()) + (tree_allocator == nullptr ? 1 : 0);
+				root_node.set_visit_count(root_node.visit_count() - original_visit);
+			}
+
+			//excute mcts iterations.
+			void ExcuteIteration(Node& root_node, stl::LinearAllocator<Allocator, _is_debug>& allocators) override
+			{
+				ExcuteTrees(root_node, nullptr, allocators);
+			}
+
+			//excute mcts on the reused tree, whose allocator is large enough to hold the merged trees of all threads.
+			Action ExcuteTreeReuseMCTS(const State& root_state)
+			{
+				timer::TimePoint tp_start;
+				StartMCTS();
+				_setting.node_storage = MctsNodeStorage::Linked;
+				Node* root_node = PrepareTreeRoot(root_state, _setting.max_node_per_thread * _setting.max_thread);
+
+				//return action if there is only one action in root node.
+				if (IsSingleActionRoot(*root_node))
+					return root_node->action(0);
+
+				stl::LinearAllocator<Allocator, _is_debug> allocators(_setting.max_thread);
+				ExcuteTrees(*root_node, _tree_allocator.get(), allocators);
+				return FinishMCTS(*root_node, tp_start);
 			}
 
 		public:
@@ -229,6 +401,8 @@ namespace gadt
 			Action Run(const State& root_state) override
 			{
 				_setting = MctsSetting();
+				if (_tree_reuse)
+					return ExcuteTreeReuseMCTS(root_state);
 				return ExcuteMCTS(root_state);
 			}
 
@@ -236,6 +410,8 @@ namespace gadt
 			Action Run(const State& root_state, MctsSetting setting) override
 			{
 				_setting = setting;
+				if (_tree_reuse)
+					return ExcuteTreeReuseMCTS(root_state);
 				auto result = ExcuteMCTS(root_state);
 				return result;
 			}